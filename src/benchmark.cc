@@ -0,0 +1,758 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "headers/s21_containers.h"
+#include "headers/s21_containersplus.h"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+template <class Function>
+double Measure(Function &&function) {
+  auto start = std::chrono::steady_clock::now();
+  function();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void Report(const char *name, size_t n, double ms) {
+  std::printf("%-44s n=%-9zu %10.2f ms %10.2f Mops/s\n", name, n, ms,
+              ms > 0 ? n / ms / 1000.0 : 0.0);
+}
+
+// Resident set size in KiB, or 0 where /proc is not available.
+long CurrentRssKb() {
+  long pages = 0, resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  if (!(statm >> pages >> resident)) return 0;
+  return resident * 4;
+}
+
+// Heap memory in use in KiB, or 0 where glibc's mallinfo2 is not available.
+// Unlike the RSS it does not depend on what earlier benchmarks freed.
+long HeapInUseKb() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  struct mallinfo2 info = mallinfo2();
+  return static_cast<long>((info.uordblks + info.hblkhd) / 1024);
+#else
+  return 0;
+#endif
+}
+
+std::vector<int> SortedKeys(size_t n) {
+  std::vector<int> keys(n);
+  for (size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i);
+  return keys;
+}
+
+std::vector<int> RandomKeys(size_t n) {
+  std::vector<int> keys = SortedKeys(n);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  return keys;
+}
+
+// S21_SET
+void BenchSetInsert(size_t n) {
+  std::vector<int> sorted = SortedKeys(n);
+  std::vector<int> random = RandomKeys(n);
+  {
+    s21::Set<int> set;
+    Report("Set insert, sorted keys", n, Measure([&] {
+             for (int key : sorted) set.insert(key);
+           }));
+  }
+  {
+    s21::Set<int> set;
+    Report("Set insert, random keys", n, Measure([&] {
+             for (int key : random) set.insert(key);
+           }));
+  }
+}
+
+void BenchSetFind(size_t n) {
+  s21::Set<int> set;
+  for (int key : RandomKeys(n)) set.insert(key);
+  std::vector<int> probes = RandomKeys(n);
+  long long sum = 0;
+  double ms = Measure([&] {
+    for (int key : probes) sum += *set.find(key) + *set.lower_bound(key);
+  });
+  Report("Set find + lower_bound", 2 * n, ms);
+  if (sum == 42) std::printf("%lld\n", sum);
+}
+
+template <class SetType>
+void BenchSetChurn(const char *name, size_t n) {
+  std::vector<int> keys = RandomKeys(2 * n);
+  long rss = CurrentRssKb();
+  double ms = 0;
+  {
+    SetType set;
+    ms = Measure([&] {
+      for (size_t i = 0; i < n; ++i) set.insert(keys[i]);
+      for (size_t i = n; i < keys.size(); ++i) {
+        set.erase(set.find(keys[i - n]));
+        set.insert(keys[i]);
+      }
+    });
+    rss = CurrentRssKb() - rss;
+  }
+  Report(name, 2 * n, ms);
+  std::printf("%-44s rss +%ld KiB\n", name, rss);
+}
+
+void BenchSetBuild(size_t n) {
+  std::vector<int> sorted = SortedKeys(n);
+  double ms = Measure([&] {
+    s21::Set<int> set;
+    for (int key : sorted) set.insert(key);
+  });
+  Report("Set build by insert, sorted keys", n, ms);
+  s21::Set<int> built;
+  ms = Measure([&] {
+    built = s21::Set<int>::from_sorted(sorted.begin(), sorted.end());
+  });
+  Report("Set::from_sorted", n, ms);
+  ms = Measure([&] { s21::Set<int> copy(built); });
+  Report("Set copy constructor", n, ms);
+}
+
+void BenchSetEraseScan(size_t n) {
+  std::vector<int> sorted = SortedKeys(n);
+  auto set = s21::Set<int>::from_sorted(sorted.begin(), sorted.end());
+  Report("Set erase every other while iterating", n / 2, Measure([&] {
+           for (auto it = set.begin(); it != set.end();)
+             it = *it % 2 ? set.erase(it) : it + 1;
+         }));
+  Report("Set erase(first, last) of the middle half", n / 4, Measure([&] {
+           set.erase(set.lower_bound(n / 4), set.lower_bound(n * 3 / 4));
+         }));
+}
+
+void BenchSetRanked(size_t n) {
+  s21::RankedSet<int> set;
+  for (int key : RandomKeys(n)) set.insert(key);
+  std::vector<int> probes = RandomKeys(n);
+  long long sum = 0;
+  double ms = Measure([&] {
+    for (int key : probes) sum += *set.nth(key) + set.rank(key);
+  });
+  Report("RankedSet nth + rank", 2 * n, ms);
+  ms = Measure([&] {
+    for (int key : probes) sum += *(set.begin() + key);
+  });
+  Report("RankedSet begin() + k", n, ms);
+  if (sum == 42) std::printf("%lld\n", sum);
+}
+
+// Two sets of n keys drawn from 2n values, so that about half are common.
+void BenchSetAlgebra(size_t n) {
+  std::vector<int> keys = RandomKeys(2 * n);
+  auto make = [&](size_t offset) {
+    std::vector<int> half(keys.begin() + offset, keys.begin() + offset + n);
+    std::sort(half.begin(), half.end());
+    return s21::Set<int>::from_sorted(half.begin(), half.end());
+  };
+  s21::Set<int> left = make(0), right = make(n / 2);
+  s21::Set<int> set = left, other = right;
+  Report("Set insert of every element of other", n, Measure([&] {
+           for (int key : right) set.insert(key);
+         }));
+  set = left;
+  Report("Set merge", n, Measure([&] { set.merge(other); }));
+  set = left;
+  Report("Set set_union", n, Measure([&] { set.set_union(right); }));
+  set = left;
+  Report("Set set_intersection", n,
+         Measure([&] { set.set_intersection(right); }));
+}
+
+// Plain and hinted insertion of one stream. The hint is the previously
+// inserted element for descending streams and the one after it otherwise.
+void BenchSetHintedStream(const char *name, const std::vector<int> &keys,
+                          bool descending = false) {
+  std::string label(name);
+  {
+    s21::Set<int> set;
+    Report((label + ", insert").c_str(), keys.size(), Measure([&] {
+             for (int key : keys) set.insert(key);
+           }));
+  }
+  s21::Set<int> set;
+  Report((label + ", insert(hint)").c_str(), keys.size(), Measure([&] {
+           auto hint = set.end();
+           for (int key : keys) {
+             hint = set.insert(hint, key);
+             if (!descending) ++hint;
+           }
+         }));
+}
+
+void BenchSetHinted(size_t n) {
+  std::vector<int> keys = SortedKeys(n);
+  BenchSetHintedStream("Set sorted stream", keys);
+  std::mt19937 random(3);
+  for (size_t i = 0; i + 8 <= n; i += 8)
+    std::shuffle(keys.begin() + i, keys.begin() + i + 8, random);
+  BenchSetHintedStream("Set near-sorted stream", keys);
+  std::reverse(keys.begin(), keys.end());
+  BenchSetHintedStream("Set near-reverse stream", keys, true);
+  BenchSetHintedStream("Set random stream", RandomKeys(n));
+}
+
+// Random batches of string keys into a set growing to n keys, inserted one
+// by one and with insert_range.
+void BenchSetBatches(size_t n, size_t batch) {
+  std::vector<std::string> keys;
+  for (int key : RandomKeys(n))
+    keys.push_back("session-" + std::to_string(key));
+  std::string label = "Set<string> batches of " + std::to_string(batch);
+  {
+    s21::Set<std::string> set;
+    Report((label + ", insert").c_str(), n, Measure([&] {
+             for (const std::string &key : keys) set.insert(key);
+           }));
+  }
+  s21::Set<std::string> set;
+  Report((label + ", insert_range").c_str(), n, Measure([&] {
+           for (size_t i = 0; i < n; i += batch)
+             set.insert_range(keys.begin() + i,
+                              keys.begin() + std::min(n, i + batch));
+         }));
+}
+
+// Counts string comparisons made through either comparator protocol.
+long long string_compares = 0;
+
+struct PredicateStringComp {
+  bool LessThan(const std::string &a, const std::string &b) const {
+    ++string_compares;
+    return a < b;
+  };
+  bool GreaterThan(const std::string &a, const std::string &b) const {
+    ++string_compares;
+    return a > b;
+  };
+  bool NotEquals(const std::string &a, const std::string &b) const {
+    ++string_compares;
+    return a != b;
+  };
+};
+
+struct ThreeWayStringComp : PredicateStringComp {
+  int Compare(const std::string &a, const std::string &b) const {
+    ++string_compares;
+    return a.compare(b);
+  };
+};
+
+template <class Comparator>
+void BenchSetStringCompares(const char *name, size_t n) {
+  s21::Set<std::string, Comparator> set;
+  std::vector<std::string> keys;
+  for (int key : RandomKeys(n)) keys.push_back("key-" + std::to_string(key));
+  for (const std::string &key : keys) set.insert(key);
+  string_compares = 0;
+  double ms = Measure([&] {
+    for (const std::string &key : keys) set.find(key);
+  });
+  Report(name, n, ms);
+  std::printf("%-44s %.1f compares per lookup\n", name,
+              static_cast<double>(string_compares) / n);
+}
+
+// S21_MAP
+void BenchMapLookup(size_t n) {
+  s21::Map<int, int> map;
+  for (int key : RandomKeys(n)) map.insert(key, key);
+  std::vector<int> probes = RandomKeys(n);
+  long long sum = 0;
+  double ms = Measure([&] {
+    for (int key : probes) sum += map.at(key) + map.contains(key) + map[key];
+  });
+  Report("Map at + contains + operator[]", 3 * n, ms);
+  if (sum == 42) std::printf("%lld\n", sum);
+}
+
+template <class MapType>
+void BenchMapTeardown(const char *name, size_t n) {
+  MapType *map = new MapType;
+  for (int key : RandomKeys(n)) map->insert(key, key);
+  Report(name, n, Measure([&] { delete map; }));
+}
+
+void BenchMapScan(size_t n) {
+  s21::Map<std::string, std::string> map;
+  for (int key : RandomKeys(n))
+    map.insert("key-" + std::to_string(key), std::string(64, 'v'));
+  size_t total = 0;
+  double ms = Measure([&] {
+    for (int round = 0; round < 10; ++round)
+      for (auto it = map.begin(); it != map.end(); ++it)
+        total += (*it).second.size();
+  });
+  Report("Map<string, string> full scan", 10 * n, ms);
+  if (total == 42) std::printf("%zu\n", total);
+}
+// Moves every entry to a new key, as a key rotation does, once by erasing
+// and inserting a copy and once by re-keying extracted nodes.
+void BenchMapRekey(size_t n) {
+  using MapType = s21::Map<std::string, std::string>;
+  MapType map;
+  for (int key : RandomKeys(n))
+    map.insert("key-" + std::to_string(key), std::string(64, 'v'));
+  std::vector<std::string> keys;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    keys.push_back((*it).first);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+  Report("Map re-key, erase + insert", n, Measure([&] {
+           for (std::string &key : keys) {
+             auto it = map.find(key);
+             std::string value = (*it).second;
+             map.erase(it);
+             key[0] = 'K';
+             map.insert(key, value);
+           }
+         }));
+  Report("Map re-key, extract + insert(node)", n, Measure([&] {
+           for (std::string &key : keys) {
+             MapType::node_type node = map.extract(key);
+             node.key()[0] = 'k';
+             key[0] = 'k';
+             map.insert(std::move(node));
+           }
+         }));
+}
+// S21_BTREE
+// Random inserts, random lookups and one in-order scan, so that the red-black
+// and the B-tree maps can be compared at sizes well beyond the caches.
+template <class MapType>
+void BenchOrderedMap(const char *name, size_t n) {
+  std::vector<int> keys = RandomKeys(n);
+  std::string label(name);
+  MapType map;
+  Report((label + " insert").c_str(), n, Measure([&] {
+           for (int key : keys) map.insert(key, key);
+         }));
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+  long long sum = 0;
+  Report((label + " find").c_str(), n, Measure([&] {
+           for (int key : keys) sum += (*map.find(key)).second;
+         }));
+  Report((label + " full scan").c_str(), n, Measure([&] {
+           for (auto it = map.begin(); it != map.end(); ++it)
+             sum += (*it).second;
+         }));
+  if (sum == 42) std::printf("%lld\n", sum);
+}
+// S21_FLAT
+// Lookups and resident memory of a read-mostly table, built in one batch.
+template <class MapType>
+void BenchLookupTable(const char *name, size_t n) {
+  std::vector<std::pair<int, int>> items;
+  for (int key : RandomKeys(n)) items.emplace_back(key, key);
+  std::vector<int> probes = RandomKeys(n);
+  std::string label(name);
+  long heap = HeapInUseKb();
+  {
+    MapType map;
+    Report((label + " build").c_str(), n, Measure([&] {
+             if constexpr (std::is_same<MapType,
+                                        s21::FlatMap<int, int>>::value) {
+               map.insert_many(items.begin(), items.end());
+             } else {
+               for (auto &item : items) map.insert(item);
+             }
+           }));
+    std::printf("%-44s heap +%ld KiB\n", name, HeapInUseKb() - heap);
+    long long sum = 0;
+    Report((label + " find").c_str(), n, Measure([&] {
+             for (int key : probes) sum += (*map.find(key)).second;
+           }));
+    if (sum == 42) std::printf("%lld\n", sum);
+  }
+}
+
+// Unordered lookups, half of them for missing keys, then erasure of every
+// key.
+template <class MapType>
+void BenchHashMap(const char *name, size_t n) {
+  std::vector<int> keys = RandomKeys(n);
+  std::vector<int> probes = RandomKeys(2 * n);
+  std::string label(name);
+  long heap = HeapInUseKb();
+  MapType map;
+  Report((label + " operator[]").c_str(), n, Measure([&] {
+           for (int key : keys) map[key] = key;
+         }));
+  std::printf("%-44s heap +%ld KiB\n", name, HeapInUseKb() - heap);
+  long long sum = 0;
+  Report((label + " find, 50% missing").c_str(), 2 * n, Measure([&] {
+           for (int key : probes) {
+             auto it = map.find(key);
+             if (it != map.end()) sum += (*it).second;
+           }
+         }));
+  Report((label + " erase").c_str(), n, Measure([&] {
+           for (int key : keys) map.erase(map.find(key));
+         }));
+  if (sum == 42) std::printf("%lld\n", sum);
+}
+
+// S21_FROZEN
+// Point queries, half of them for missing keys, on a Set of n spread-out
+// 64-bit keys and on its frozen and flat copies.
+template <class SetType>
+void BenchPointQueries(const char *name, SetType &set,
+                       const std::vector<uint64_t> &probes) {
+  size_t hits = 0;
+  Report(name, probes.size(), Measure([&] {
+           for (uint64_t key : probes) hits += set.contains(key);
+         }));
+  if (hits == 42) std::printf("%zu\n", hits);
+}
+
+void BenchFrozenSet(size_t n) {
+  s21::Set<uint64_t> set;
+  for (int key : RandomKeys(n)) set.insert(uint64_t(key) * 2);
+  std::vector<uint64_t> probes;
+  for (int key : RandomKeys(2 * n)) probes.push_back(key);
+  s21::FrozenSet<uint64_t> frozen = set.freeze();
+  s21::FlatSet<uint64_t> flat;
+  flat.insert_many(frozen.begin(), frozen.end());
+  std::string label = "contains, n=" + std::to_string(n) + ", ";
+  BenchPointQueries((label + "Set").c_str(), set, probes);
+  BenchPointQueries((label + "FlatSet").c_str(), flat, probes);
+  BenchPointQueries((label + "FrozenSet").c_str(), frozen, probes);
+}
+
+// The same probes one at a time and in lockstep groups.
+void BenchBatchedLookups(size_t n) {
+  s21::Set<uint64_t> set;
+  for (int key : RandomKeys(n)) set.insert(uint64_t(key) * 2);
+  std::vector<uint64_t> probes;
+  for (int key : RandomKeys(2 * n)) probes.push_back(key);
+  std::string label = "contains, n=" + std::to_string(n) + ", ";
+  BenchPointQueries((label + "loop").c_str(), set, probes);
+  std::vector<char> found(probes.size());
+  Report((label + "contains_many").c_str(), probes.size(), Measure([&] {
+           set.contains_many(probes.begin(), probes.end(), found.begin());
+         }));
+  size_t hits = 0;
+  for (size_t i = 0; i < probes.size(); ++i) hits += found[i];
+  if (hits == 42) std::printf("%zu\n", hits);
+}
+
+// S21_MULTISET
+// n keys drawn from only distinct values, as in a histogram.
+template <class MultisetType>
+void BenchMultisetDuplicates(const char *name, size_t n, size_t distinct) {
+  std::vector<int> keys = RandomKeys(n);
+  for (int &key : keys) key %= static_cast<int>(distinct);
+  std::string label(name);
+  long heap = HeapInUseKb();
+  MultisetType set;
+  Report((label + " insert").c_str(), n, Measure([&] {
+           for (int key : keys) set.insert(key);
+         }));
+  std::printf("%-44s heap +%ld KiB\n", name, HeapInUseKb() - heap);
+  size_t total = 0;
+  Report((label + " count").c_str(), distinct, Measure([&] {
+           for (size_t key = 0; key < distinct; ++key) total += set.count(key);
+         }));
+  if (total != n) std::printf("count mismatch\n");
+}
+
+// S21_CONCURRENT_MAP
+// The baseline the services use today: one Map behind one mutex.
+class LockedMap {
+ public:
+  bool find(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+
+  void insert_or_assign(int key, int value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.insert_or_assign(key, value);
+  }
+
+  void erase(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(key);
+    if (it != map_.end()) map_.erase(it);
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::Map<int, int> map_;
+};
+
+// ops operations split over threads on keys of a prefilled map; one in
+// write_every is a write (half inserts, half erases), the rest are finds.
+template <class MapType>
+void BenchConcurrentMix(const char *name, size_t threads, size_t ops,
+                        size_t write_every) {
+  const int kKeys = 100000;
+  MapType map;
+  for (int key = 0; key < kKeys; key += 2) map.insert_or_assign(key, key);
+  std::vector<std::thread> workers;
+  std::atomic<size_t> hits{0};
+  double ms = Measure([&] {
+    for (size_t t = 0; t < threads; ++t)
+      workers.emplace_back([&, t] {
+        std::mt19937 random(static_cast<unsigned>(t));
+        size_t found = 0;
+        for (size_t i = 0; i < ops / threads; ++i) {
+          int key = static_cast<int>(random() % kKeys);
+          if (i % write_every) {
+            found += static_cast<bool>(map.find(key));
+          } else if (i / write_every % 2) {
+            map.insert_or_assign(key, key);
+          } else {
+            map.erase(key);
+          }
+        }
+        hits += found;
+      });
+    for (auto &worker : workers) worker.join();
+  });
+  std::string label =
+      std::string(name) + ", " + std::to_string(threads) + " threads";
+  Report(label.c_str(), ops, ms);
+  if (hits == 42) std::printf("%zu\n", hits.load());
+}
+
+void BenchConcurrentMaps(size_t ops) {
+  for (size_t write_every : {20, 2}) {
+    std::printf("%s\n", write_every == 20 ? "95% reads" : "50% reads");
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+      BenchConcurrentMix<LockedMap>("Map behind one mutex", threads, ops,
+                                    write_every);
+      BenchConcurrentMix<s21::ConcurrentMap<int, int>>(
+          "ConcurrentMap, 64 shards", threads, ops, write_every);
+    }
+  }
+}
+
+class LockedSet {
+ public:
+  bool contains(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return set_.contains(key);
+  }
+
+  void insert(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    set_.insert(key);
+  }
+
+  void erase(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = set_.find(key);
+    if (it != set_.end()) set_.erase(it);
+  }
+
+ private:
+  std::mutex mutex_;
+  s21::Set<int> set_;
+};
+
+// The set counterpart of BenchConcurrentMix.
+template <class SetType>
+void BenchConcurrentSetMix(const char *name, size_t threads, size_t ops,
+                           size_t write_every) {
+  const int kKeys = 100000;
+  // Filled in random order: sorted insertion would leave the tree nodes
+  // in address order and flatter it.
+  std::vector<int> keys;
+  for (int key = 0; key < kKeys; key += 2) keys.push_back(key);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  SetType set;
+  for (int key : keys) set.insert(key);
+  std::vector<std::thread> workers;
+  std::atomic<size_t> hits{0};
+  double ms = Measure([&] {
+    for (size_t t = 0; t < threads; ++t)
+      workers.emplace_back([&, t] {
+        std::mt19937 random(static_cast<unsigned>(t));
+        size_t found = 0;
+        for (size_t i = 0; i < ops / threads; ++i) {
+          int key = static_cast<int>(random() % kKeys);
+          if (i % write_every) {
+            found += set.contains(key);
+          } else if (i / write_every % 2) {
+            set.insert(key);
+          } else {
+            set.erase(key);
+          }
+        }
+        hits += found;
+      });
+    for (auto &worker : workers) worker.join();
+  });
+  std::string label =
+      std::string(name) + ", " + std::to_string(threads) + " threads";
+  Report(label.c_str(), ops, ms);
+  if (hits == 42) std::printf("%zu\n", hits.load());
+}
+
+void BenchConcurrentSets(size_t ops) {
+  for (size_t write_every : {20, 2}) {
+    std::printf("%s\n", write_every == 20 ? "95% reads" : "50% reads");
+    for (size_t threads = 1; threads <= 16; threads *= 2) {
+      BenchConcurrentSetMix<LockedSet>("Set behind one mutex", threads, ops,
+                                       write_every);
+      BenchConcurrentSetMix<s21::ConcurrentSkipSet<int>>(
+          "ConcurrentSkipSet", threads, ops, write_every);
+    }
+  }
+}
+
+class SharedLockedMap {
+ public:
+  bool contains(int key) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return map_.contains(key);
+  }
+
+  void insert_or_assign(int key, int value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    map_.insert_or_assign(key, value);
+  }
+
+ private:
+  std::shared_mutex mutex_;
+  s21::Map<int, int> map_;
+};
+
+// Every read looks at the current version on its own.
+class SnapshotMap {
+ public:
+  bool contains(int key) {
+    return map_.read([key](const s21::PersistentMap<int, int> &version) {
+      return version.contains(key);
+    });
+  }
+
+  void insert_or_assign(int key, int value) {
+    map_.store(map_.load().insert_or_assign(key, value));
+  }
+
+ private:
+  s21::AtomicPersistentMap<int, int> map_;
+};
+
+// ops lookups split over readers while one writer keeps replacing values
+// until they are done.
+template <class MapType>
+void BenchReadsDuringWrites(const char *name, size_t readers, size_t ops) {
+  const int kKeys = 100000;
+  MapType map;
+  for (int key : RandomKeys(kKeys)) map.insert_or_assign(key, key);
+  std::atomic<bool> done{false};
+  size_t writes = 0;
+  std::thread writer([&] {
+    std::mt19937 random(7);
+    for (; !done; ++writes)
+      map.insert_or_assign(static_cast<int>(random() % kKeys), 0);
+  });
+  std::atomic<size_t> hits{0};
+  std::vector<std::thread> workers;
+  double ms = Measure([&] {
+    for (size_t t = 0; t < readers; ++t)
+      workers.emplace_back([&, t] {
+        std::mt19937 random(static_cast<unsigned>(t));
+        size_t found = 0;
+        for (size_t i = 0; i < ops / readers; ++i)
+          found += map.contains(static_cast<int>(random() % (2 * kKeys)));
+        hits += found;
+      });
+    for (auto &worker : workers) worker.join();
+  });
+  done = true;
+  writer.join();
+  std::string label =
+      std::string(name) + ", " + std::to_string(readers) + " readers";
+  Report(label.c_str(), ops, ms);
+  std::printf("%-44s %zu writes meanwhile\n", "", writes);
+  if (hits == 42) std::printf("%zu\n", hits.load());
+}
+
+void BenchSnapshotReads(size_t ops) {
+  for (size_t readers = 1; readers <= 8; readers *= 2) {
+    BenchReadsDuringWrites<SharedLockedMap>("Map behind a shared_mutex",
+                                            readers, ops);
+    BenchReadsDuringWrites<SnapshotMap>("AtomicPersistentMap", readers, ops);
+  }
+}
+
+}  // namespace
+
+// Pass --large to add a 50M key run of the map comparison, which needs
+// several GiB of memory.
+int main(int argc, char **argv) {
+  bool large = argc > 1 && std::string(argv[1]) == "--large";
+  // These run first so that the RSS deltas are not hidden by memory that
+  // earlier benchmarks left in the malloc arenas.
+  BenchSetChurn<s21::Set<int, s21::SingleComp<int>, s21::PoolAllocator>>(
+      "Set churn, pooled nodes", 1000000);
+  BenchSetChurn<s21::Set<int>>("Set churn, heap nodes", 1000000);
+  BenchLookupTable<s21::FlatMap<int, int>>("FlatMap<int, int>", 1000000);
+  BenchLookupTable<s21::Map<int, int>>("Map<int, int>", 1000000);
+  BenchHashMap<s21::UnorderedMap<int, int>>("UnorderedMap<int, int>", 1000000);
+  BenchHashMap<std::unordered_map<int, int>>("std::unordered_map<int, int>",
+                                             1000000);
+  BenchHashMap<s21::Map<int, int>>("Map<int, int>", 1000000);
+  BenchSetInsert(1000000);
+  BenchSetFind(1000000);
+  BenchSetBuild(1000000);
+  BenchSetEraseScan(1000000);
+  BenchSetRanked(1000000);
+  BenchSetAlgebra(1000000);
+  BenchSetHinted(1000000);
+  BenchSetBatches(1000000, 10000);
+  BenchSetBatches(1000000, 100000);
+  BenchFrozenSet(10000);
+  BenchFrozenSet(1000000);
+  BenchBatchedLookups(10000);
+  BenchBatchedLookups(1000000);
+  BenchSetStringCompares<PredicateStringComp>("Set<string> find, predicates",
+                                              1000000);
+  BenchSetStringCompares<ThreeWayStringComp>("Set<string> find, three-way",
+                                             1000000);
+  for (size_t n = 1000; n <= 1000000; n *= 10) BenchMapLookup(n);
+  BenchMapScan(100000);
+  BenchMapRekey(100000);
+  BenchMultisetDuplicates<s21::Multiset<int>>("Multiset, 1000 distinct keys",
+                                              1000000, 1000);
+  BenchMultisetDuplicates<s21::RunLengthMultiset<int>>(
+      "RunLengthMultiset, 1000 distinct keys", 1000000, 1000);
+  BenchMapTeardown<s21::Map<int, int>>("Map destructor, heap nodes", 10000000);
+  BenchMapTeardown<
+      s21::Map<int, int, s21::PairComp<int, int>, s21::PoolAllocator>>(
+      "Map destructor, pooled nodes", 10000000);
+  BenchConcurrentMaps(2000000);
+  BenchConcurrentSets(2000000);
+  BenchSnapshotReads(2000000);
+  for (size_t n : {1000000, 10000000, 50000000}) {
+    if (n > 10000000 && !large) break;
+    BenchOrderedMap<s21::Map<int, int>>("Map<int, int>", n);
+    BenchOrderedMap<s21::BTreeMap<int, int>>("BTreeMap<int, int>", n);
+  }
+  return 0;
+}
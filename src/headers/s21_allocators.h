@@ -0,0 +1,201 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_ALLOCATORS_H_
+#define S21_CONTAINERS_HEADERS_S21_ALLOCATORS_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace s21 {
+// Node allocation policies for BinaryTree. A policy hands out constructed
+// nodes with Allocate, destroys them with Deallocate and may drop all of its
+// memory at once with Release when no nodes are alive; Release returns
+// whether it did. Discard destroys a node that is about to go away with the
+// rest of the tree; when kReclaimsOnRelease is set, its memory is recovered
+// by Release instead. kIsAlwaysEqual tells whether a node allocated by one
+// instance may be freed by another one.
+//
+// Node handles take nodes out of a tree. Lend returns the Lender a handle
+// keeps with its node, which may outlive the policy instance; Repay takes a
+// lent node back into the instance, or returns false if it belongs to
+// another one; Forfeit frees a lent node that is not coming back.
+template <class Node>
+struct HeapAllocator {
+  static constexpr bool kIsAlwaysEqual = true;
+  static constexpr bool kReclaimsOnRelease = false;
+
+  using Lender = std::nullptr_t;
+
+  template <class... Args>
+  Node *Allocate(Args &&...args) {
+    return new Node(std::forward<Args>(args)...);
+  };
+
+  void Deallocate(Node *node) { delete node; };
+
+  void Discard(Node *node) { delete node; };
+
+  bool Release() { return true; };
+
+  Lender Lend(Node *) { return nullptr; };
+
+  bool Repay(Lender, Node *) { return true; };
+
+  static void Forfeit(Lender, Node *node) { delete node; };
+};
+
+// Hands out nodes from slabs that double in size up to kMaxSlabNodes, reusing
+// freed nodes through an intrusive free list. Slabs are only returned to the
+// system by Release or the destructor. They live in a Pool of their own that
+// counts the nodes lent to handles: Release keeps a pool with lent nodes,
+// and a destroyed allocator leaves it to the last handle to free.
+template <class Node>
+class PoolAllocator {
+  struct Pool;
+
+ public:
+  static constexpr bool kIsAlwaysEqual = false;
+  static constexpr bool kReclaimsOnRelease = true;
+
+  using Lender = Pool *;
+
+  PoolAllocator(){};
+  PoolAllocator(const PoolAllocator &other) = delete;
+  PoolAllocator(PoolAllocator &&other) { swap(other); };
+
+  ~PoolAllocator() {
+    if (!pool_) return;
+    if (pool_->lent) {
+      pool_->orphaned = true;
+    } else {
+      Free(pool_);
+      delete pool_;
+    }
+  };
+
+  PoolAllocator &operator=(const PoolAllocator &other) = delete;
+  PoolAllocator &operator=(PoolAllocator &&other) {
+    swap(other);
+    return *this;
+  };
+
+  template <class... Args>
+  Node *Allocate(Args &&...args) {
+    if (!pool_) pool_ = new Pool;
+    Slot *slot = pool_->free;
+    if (slot) {
+      pool_->free = slot->next;
+    } else {
+      if (pool_->used == pool_->capacity) Grow();
+      slot = SlabSlots(pool_->slabs) + pool_->used++;
+    }
+    try {
+      return new (slot->storage) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      Recycle(pool_, slot);
+      throw;
+    }
+  };
+
+  void Deallocate(Node *node) {
+    node->~Node();
+    Recycle(pool_, reinterpret_cast<Slot *>(node));
+  };
+
+  // Frees the slot right away while nodes are lent, as Release will not.
+  void Discard(Node *node) {
+    if (pool_->lent) {
+      Deallocate(node);
+    } else {
+      node->~Node();
+    }
+  };
+
+  bool Release() {
+    if (!pool_) return true;
+    if (pool_->lent) return false;
+    Free(pool_);
+    return true;
+  };
+
+  Lender Lend(Node *) {
+    ++pool_->lent;
+    return pool_;
+  };
+
+  bool Repay(Lender pool, Node *) {
+    if (pool != pool_) return false;
+    --pool_->lent;
+    return true;
+  };
+
+  static void Forfeit(Lender pool, Node *node) {
+    node->~Node();
+    --pool->lent;
+    if (!pool->orphaned) {
+      Recycle(pool, reinterpret_cast<Slot *>(node));
+    } else if (!pool->lent) {
+      Free(pool);
+      delete pool;
+    }
+  };
+
+  void swap(PoolAllocator &other) { std::swap(pool_, other.pool_); };
+
+ private:
+  static constexpr size_t kMinSlabNodes = 16;
+  static constexpr size_t kMaxSlabNodes = 4096;
+
+  union Slot {
+    Slot *next;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  struct alignas(Slot) Slab {
+    Slab *next;
+  };
+
+  struct Pool {
+    Slab *slabs = nullptr;
+    Slot *free = nullptr;
+    size_t used = 0;
+    size_t capacity = 0;
+    size_t lent = 0;
+    bool orphaned = false;
+  };
+
+  Pool *pool_ = nullptr;
+
+  static Slot *SlabSlots(Slab *slab) {
+    return reinterpret_cast<Slot *>(slab + 1);
+  };
+
+  static void Recycle(Pool *pool, Slot *slot) {
+    slot->next = pool->free;
+    pool->free = slot;
+  };
+
+  // Returns the slabs to the system and leaves the pool empty.
+  static void Free(Pool *pool) {
+    while (pool->slabs) {
+      Slab *next = pool->slabs->next;
+      ::operator delete(pool->slabs);
+      pool->slabs = next;
+    }
+    pool->free = nullptr;
+    pool->used = pool->capacity = 0;
+  };
+
+  void Grow() {
+    size_t capacity = pool_->capacity ? pool_->capacity * 2 : kMinSlabNodes;
+    if (capacity > kMaxSlabNodes) capacity = kMaxSlabNodes;
+    Slab *slab = static_cast<Slab *>(
+        ::operator new(sizeof(Slab) + capacity * sizeof(Slot)));
+    slab->next = pool_->slabs;
+    pool_->slabs = slab;
+    pool_->used = 0;
+    pool_->capacity = capacity;
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_ALLOCATORS_H_
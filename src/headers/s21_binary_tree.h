@@ -1,13 +1,33 @@
 #ifndef S21_CONTAINERS_HEADERS_S21_BINARY_TREE_H_
 #define S21_CONTAINERS_HEADERS_S21_BINARY_TREE_H_
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <optional>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
+#include "s21_allocators.h"
 #include "s21_comparators.h"
 
-template <class Key, class Compare = s21::SingleComp<Key>>
+namespace s21 {
+// Extra node field of order-statistic trees: the number of real nodes in the
+// subtree. Nil sentinels keep zero.
+template <bool Ranked>
+struct SubtreeSize {};
+
+template <>
+struct SubtreeSize<true> {
+  size_t subtree_size_ = 0;
+};
+}  // namespace s21
+
+template <class Key, class Compare = s21::SingleComp<Key>,
+          template <class> class Allocator = s21::HeapAllocator,
+          bool Ranked = false>
 class BinaryTree {
  public:
   using key_type = Key;
@@ -17,20 +37,70 @@ class BinaryTree {
   using const_reference = const key_type &;
   using size_type = size_t;
 
-  struct Node {
-    Node(key_type key, Node *right = nullptr, Node *left = nullptr,
-         Node *parent = nullptr) {
-      data_ = key;
-      right_ = right;
-      left_ = left;
-      parent_ = parent;
-    };
-    ~Node(){};
+  // The element is built in place from the constructor arguments; links
+  // are set when the node is hung into a tree.
+  struct Node : s21::SubtreeSize<Ranked> {
+    template <class... Args>
+    explicit Node(Args &&...args) : data_(std::forward<Args>(args)...){};
 
     key_type data_;
-    Node *left_;
-    Node *right_;
-    Node *parent_;
+    Node *left_ = nullptr;
+    Node *right_ = nullptr;
+    Node *parent_ = nullptr;
+    bool red_ = false;
+  };
+
+  // In-order neighbours, found from the links alone. The nil sentinels loop
+  // onto themselves, so stepping past either end stays on the sentinel.
+  static Node *Next(Node *node) {
+    if (node->right_) {
+      node = node->right_;
+      while (node->left_) node = node->left_;
+    } else {
+      Node *parent = node->parent_;
+      while (parent->right_ == node) {
+        node = parent;
+        parent = parent->parent_;
+      }
+      node = parent;
+    }
+    return node;
+  };
+
+  static Node *Prev(Node *node) {
+    if (node->left_) {
+      node = node->left_;
+      while (node->right_) node = node->right_;
+    } else {
+      Node *parent = node->parent_;
+      while (parent->left_ == node) {
+        node = parent;
+        parent = parent->parent_;
+      }
+      node = parent;
+    }
+    return node;
+  };
+
+  // The node n steps away. Ranked trees climb to the root and select by
+  // subtree sizes in O(log n), other trees step n times.
+  static Node *Advance(Node *node, long long n) {
+    if constexpr (Ranked) {
+      if (n && (Size(node) || Size(node->parent_))) {
+        long long rank = node->left_ == node ? -1 : Size(node->left_);
+        Node *root = node;
+        while (root->parent_) {
+          if (root->parent_->right_ == root)
+            rank += Size(root->parent_->left_) + 1;
+          root = root->parent_;
+        }
+        node = Select(root, rank + n);
+      }
+    } else {
+      for (; n > 0; --n) node = Next(node);
+      for (; n < 0; ++n) node = Prev(node);
+    }
+    return node;
   };
 
   class Iterator {
@@ -54,17 +124,7 @@ class BinaryTree {
     value_type &operator*() const { return address_->data_; };
 
     Iterator &operator++() {
-      if (this->address_->right_) {
-        this->address_ = this->address_->right_;
-        while (this->address_->left_) this->address_ = this->address_->left_;
-      } else if (this->address_->parent_->left_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator.GreaterThan(tmp, this->address_->data_));
-      }
+      address_ = Next(address_);
       return *this;
     };
 
@@ -75,17 +135,7 @@ class BinaryTree {
     };
 
     Iterator &operator--() {
-      if (this->address_->left_) {
-        this->address_ = this->address_->left_;
-        while (this->address_->right_) this->address_ = this->address_->right_;
-      } else if (this->address_->parent_->right_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator.LessThan(tmp, this->address_->data_));
-      }
+      address_ = Prev(address_);
       return *this;
     };
 
@@ -95,25 +145,17 @@ class BinaryTree {
       return tmp;
     };
 
-    Iterator operator+(int n) {
-      Iterator tmp = *this;
-      for (int i = 0; i < n; ++i) ++tmp;
-      return tmp;
-    };
+    Iterator operator+(int n) { return Iterator(Advance(address_, n)); };
 
-    Iterator operator-(int n) {
-      Iterator tmp = *this;
-      for (int i = 0; i < n; ++i) --tmp;
-      return tmp;
-    };
+    Iterator operator-(int n) { return Iterator(Advance(address_, -n)); };
 
     Iterator operator+=(int n) {
-      for (int i = 0; i < n; ++i) ++*this;
+      address_ = Advance(address_, n);
       return *this;
     };
 
     Iterator operator-=(int n) {
-      for (int i = 0; i < n; ++i) --*this;
+      address_ = Advance(address_, -n);
       return *this;
     };
 
@@ -126,7 +168,6 @@ class BinaryTree {
     };
 
    private:
-    key_compare comparator;
     Node *address_;
   };
 
@@ -151,17 +192,7 @@ class BinaryTree {
     const_reference operator*() const { return address_->data_; };
 
     ConstIterator &operator++() {
-      if (this->address_->right_) {
-        this->address_ = this->address_->right_;
-        while (this->address_->left_) this->address_ = this->address_->left_;
-      } else if (this->address_->parent_->left_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator.GreaterThan(tmp, this->address_->data_));
-      }
+      address_ = Next(address_);
       return *this;
     };
 
@@ -172,17 +203,7 @@ class BinaryTree {
     };
 
     ConstIterator &operator--() {
-      if (this->address_->left_) {
-        this->address_ = this->address_->left_;
-        while (this->address_->right_) this->address_ = this->address_->right_;
-      } else if (this->address_->parent_->right_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator.LessThan(tmp, this->address_->data_));
-      }
+      address_ = Prev(address_);
       return *this;
     };
 
@@ -193,24 +214,20 @@ class BinaryTree {
     };
 
     ConstIterator operator+(int n) {
-      ConstIterator tmp = *this;
-      for (int i = 0; i < n; ++i) ++tmp;
-      return tmp;
+      return ConstIterator(Advance(address_, n));
     };
 
     ConstIterator operator-(int n) {
-      ConstIterator tmp = *this;
-      for (int i = 0; i < n; ++i) --tmp;
-      return tmp;
+      return ConstIterator(Advance(address_, -n));
     };
 
     ConstIterator operator+=(int n) {
-      for (int i = 0; i < n; ++i) ++*this;
+      address_ = Advance(address_, n);
       return *this;
     };
 
     ConstIterator operator-=(int n) {
-      for (int i = 0; i < n; ++i) --*this;
+      address_ = Advance(address_, -n);
       return *this;
     };
 
@@ -223,49 +240,138 @@ class BinaryTree {
     };
 
    private:
-    key_compare comparator;
     Node *address_;
   };
 
+  // Owns a node taken out of a tree by extract, so that it can be inserted
+  // into a tree of the same type without freeing, allocating or copying the
+  // element. Pooled nodes stay in the pool of their tree: a handle from a
+  // pooled tree must not outlive that tree, and moving its node into
+  // another tree copies the element.
+  class NodeHandle {
+   public:
+    NodeHandle() : node_(nullptr), lender_(){};
+    NodeHandle(const NodeHandle &other) = delete;
+    NodeHandle(NodeHandle &&other)
+        : node_(other.node_), lender_(other.lender_) {
+      other.node_ = nullptr;
+    };
+    ~NodeHandle() { Reset(); };
+
+    NodeHandle &operator=(const NodeHandle &other) = delete;
+    NodeHandle &operator=(NodeHandle &&other) {
+      NodeHandle tmp(std::move(other));
+      swap(tmp);
+      return *this;
+    };
+
+    bool empty() const { return !node_; };
+
+    explicit operator bool() const { return node_; };
+
+    value_type &value() const { return node_->data_; };
+
+    // Maps only. The key may be changed before the node is inserted again.
+    auto &key() const { return node_->data_.first; };
+
+    auto &mapped() const { return node_->data_.second; };
+
+    void swap(NodeHandle &other) {
+      std::swap(node_, other.node_);
+      std::swap(lender_, other.lender_);
+    };
+
+   private:
+    friend class BinaryTree;
+    using Lender = typename Allocator<Node>::Lender;
+
+    Node *node_;
+    // Keeps the memory of the node alive, even past the tree it came from.
+    Lender lender_;
+
+    NodeHandle(Node *node, Lender lender) : node_(node), lender_(lender){};
+
+    Node *Release() {
+      Node *node = node_;
+      node_ = nullptr;
+      return node;
+    };
+
+    void Reset() {
+      if (node_) Allocator<Node>::Forfeit(lender_, Release());
+    };
+  };
+
   using iterator = Iterator;
   using const_iterator = ConstIterator;
+  using node_type = NodeHandle;
 
-  iterator begin() {
-    iterator tmp(begin_nil_);
-    if (size_) ++tmp;
-    return tmp;
+  // Result of inserting a node handle: where the element is, and the handle
+  // back when an equal element was already present.
+  struct InsertReturn {
+    iterator position;
+    bool inserted;
+    node_type node;
   };
 
+  using insert_return_type = InsertReturn;
+
+  iterator begin() { return iterator(size_ ? Next(begin_nil_) : end_nil_); };
+
   iterator end() { return iterator(end_nil_); };
 
   const_iterator cbegin() const {
-    const_iterator tmp(begin_nil_);
-    if (size_) ++tmp;
-    return tmp;
+    return const_iterator(size_ ? Next(begin_nil_) : end_nil_);
   };
 
   const_iterator cend() const { return const_iterator(end_nil_); };
 
-  bool empty() { return !(bool)size_; };
+  bool empty() const { return !(bool)size_; };
+
+  size_type size() const { return size_; };
 
-  size_type size() { return size_; };
+  // Ranked trees only: the k-th smallest element, or end() past the last one.
+  iterator nth(size_type k) {
+    static_assert(Ranked, "nth needs an order-statistic tree");
+    return iterator(k < size_ ? Select(root_, k) : end_nil_);
+  };
 
   size_type max_size() const {
     return std::numeric_limits<size_type>::max() / (2 * sizeof(Node));
   };
 
+  // Frees the nodes in one post-order pass. Pooled trees of trivially
+  // destructible elements skip the walk and just drop their slabs, unless
+  // node handles still hold some of them.
   void clear() {
-    if (size_) {
-      iterator it = begin();
-      while (it != end()) {
-        iterator tmp = it + 1;
-        erase(it);
-        it = tmp;
-      }
+    bool released = false;
+    if (root_) {
+      if constexpr (Allocator<Node>::kReclaimsOnRelease &&
+                    std::is_trivially_destructible<Node>::value)
+        released = allocator_.Release();
+      if (!released) DestroySubtree(root_);
+      DeleteRoot();
+      size_ = 0;
     }
+    if (!released) allocator_.Release();
   };
 
-  void erase(iterator pos) { DeleteOrExtract(pos, true); };
+  iterator erase(iterator pos) {
+    iterator next = pos;
+    if (IsNode(pos.node())) ++next;
+    DeleteOrExtract(pos, true);
+    return next;
+  };
+
+  // Removes [first, last); a span covering the whole tree is cleared.
+  iterator erase(iterator first, iterator last) {
+    if (first == begin() && last == end()) {
+      clear();
+    } else {
+      while (first != last) first = erase(first);
+    }
+    return last;
+  };
 
   void swap(BinaryTree &other) {
     Node *tmp_root = this->root_;
@@ -280,6 +386,7 @@ class BinaryTree {
     other.end_nil_ = tmp_end_nil;
     other.begin_nil_ = tmp_begin_nil;
     other.size_ = tmp;
+    std::swap(allocator_, other.allocator_);
   };
 
  protected:
@@ -288,46 +395,450 @@ class BinaryTree {
   Node *end_nil_;
   Node *begin_nil_;
   key_compare comparator;
+  Allocator<Node> allocator_;
+
+  // Lookups that FindMany keeps in flight together.
+  static constexpr size_type kLookupGroup = 16;
 
   void ChangeParentsChild(Node *parent, Node *old_child, Node *new_child) {
     parent->left_ == old_child ? parent->left_ = new_child
                                : parent->right_ = new_child;
   };
 
+  // Unlinks the node at pos straight from its links, freeing it if del.
   void DeleteOrExtract(iterator pos, bool del) {
-    if (pos.node() && pos.node() != end_nil_ && pos.node() != begin_nil_) {
-      key_type tmp = *pos;
-      Node *node = root_;
-      Node *parent = Search(tmp, node);
-
-      if (IsLeaf(node)) {
-        DeleteLeaf(node);
-      } else if (Node *child = HasOneChild(node)) {
-        DeleteWithChild(node, child);
+    Node *node = pos.node();
+    if (IsNode(node)) {
+      if (size_ == 1) {
+        DeleteRoot();
       } else {
-        if (node->left_ == begin_nil_ && node->right_ == end_nil_) {
-          DeleteRoot();
-        } else if (node->left_ != begin_nil_ && node->right_ != end_nil_) {
-          DeleteWithWwo(node, parent);
-        } else {
-          if (node->left_ == begin_nil_) {
-            DeleteWithNilInLeft(node, parent);
-          } else {
-            DeleteWithNilInRight(node, parent);
-          }
+        Node *new_min = node->left_ == begin_nil_ ? Next(node) : nullptr;
+        Node *new_max = node->right_ == end_nil_ ? Prev(node) : nullptr;
+        if (new_min) node->left_ = nullptr;
+        if (new_max) node->right_ = nullptr;
+        Unlink(node);
+        if (new_min) {
+          new_min->left_ = begin_nil_;
+          begin_nil_->parent_ = new_min;
+        }
+        if (new_max) {
+          new_max->right_ = end_nil_;
+          end_nil_->parent_ = new_max;
         }
       }
-      if (del) delete node;
+      if (del) allocator_.Deallocate(node);
       --size_;
     }
   };
 
+  node_type Extract(iterator pos) {
+    if (!IsNode(pos.node())) return node_type();
+    DeleteOrExtract(pos, false);
+    return node_type(pos.node(), allocator_.Lend(pos.node()));
+  };
+
+  // Links the node of handle in unless an equal element is present. Nodes
+  // of another pool are copied into this one.
+  insert_return_type Paste(node_type &&handle) {
+    if (handle.empty()) return insert_return_type{end(), false, node_type()};
+    Node *tmp = root_;
+    int order = 0;
+    Node *parent = Search(handle.value(), tmp, order);
+    if (IsNode(tmp))
+      return insert_return_type{iterator(tmp), false, std::move(handle)};
+    Node *node = handle.node_;
+    if (allocator_.Repay(handle.lender_, node)) {
+      handle.Release();
+    } else {
+      node = allocator_.Allocate(std::move(handle.value()));
+      handle.Reset();
+    }
+    Link(node, parent, tmp, order);
+    return insert_return_type{iterator(node), true, node_type()};
+  };
+
   std::pair<iterator, bool> InsertOrPaste(const key_type &key,
                                           Node *node = nullptr) {
-    Node *insertible = !node ? new Node(key) : node;
-    std::pair<iterator, bool> pair(iterator(insertible), true);
+    return InsertUnique(key,
+                        [&] { return node ? node : allocator_.Allocate(key); });
+  };
+
+  // Inserts the node make() returns unless an element equal to key is
+  // present. make is only called when key is missing.
+  template <class K, class Make>
+  std::pair<iterator, bool> InsertUnique(const K &key, Make make) {
+    Node *tmp = root_;
+    int order = 0;
+    Node *parent = Search(key, tmp, order);
+    if (IsNode(tmp)) return std::pair<iterator, bool>(iterator(tmp), false);
+    Node *insertible = make();
+    Link(insertible, parent, tmp, order);
+    return std::pair<iterator, bool>(iterator(insertible), true);
+  };
+
+  // Builds the element first, so it is freed again if its key is present.
+  template <class... Args>
+  std::pair<iterator, bool> EmplaceUnique(Args &&...args) {
+    Node *node = allocator_.Allocate(std::forward<Args>(args)...);
+    std::pair<iterator, bool> result = InsertOrPaste(node->data_, node);
+    if (!result.second) allocator_.Deallocate(node);
+    return result;
+  };
+
+  // Batch insertion. The elements are built in nodes first, then inserted
+  // in ascending order, each search starting from the previous insertion
+  // point rather than the root; an empty tree is built in O(m) instead.
+  // Results follow the order of the arguments. With unique, elements equal
+  // to one present or earlier in the batch are freed again.
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> InsertMany(bool unique,
+                                                    Args &&...args) {
+    std::vector<Node *> nodes;
+    nodes.reserve(sizeof...(args));
+    try {
+      (AllocateInto(nodes, std::forward<Args>(args)), ...);
+    } catch (...) {
+      for (Node *node : nodes)
+        if (node) allocator_.Deallocate(node);
+      throw;
+    }
+    return InsertBatch(nodes, unique);
+  };
+
+  template <class InputIt>
+  std::vector<std::pair<iterator, bool>> InsertRange(bool unique,
+                                                     InputIt first,
+                                                     InputIt last) {
+    std::vector<Node *> nodes;
+    try {
+      for (; first != last; ++first) AllocateInto(nodes, *first);
+    } catch (...) {
+      for (Node *node : nodes)
+        if (node) allocator_.Deallocate(node);
+      throw;
+    }
+    return InsertBatch(nodes, unique);
+  };
+
+  // Inserts key next to hint when that is its place, else as InsertOrPaste
+  // does. A given node is linked in, or freed if key is already present.
+  std::pair<iterator, bool> InsertNear(iterator hint, const key_type &key,
+                                       Node *node = nullptr) {
+    Node *tmp = nullptr;
+    int order = 0;
+    Node *parent = SearchNear(hint.node(), key, tmp, order);
+    if (IsNode(tmp)) {
+      if (node) allocator_.Deallocate(node);
+      return std::pair<iterator, bool>(iterator(tmp), false);
+    }
+    Node *insertible = !node ? allocator_.Allocate(key) : node;
+    Link(insertible, parent, tmp, order);
+    return std::pair<iterator, bool>(iterator(insertible), true);
+  };
+
+  // Inserts key even if equal elements exist, after all of them.
+  iterator InsertEqual(const key_type &key, Node *node = nullptr) {
+    Node *parent = nullptr;
+    Node *tmp = root_;
+    int order = 0;
+    while (IsNode(tmp)) {
+      parent = tmp;
+      order = Order(key, tmp->data_) < 0 ? -1 : 1;
+      tmp = order < 0 ? tmp->left_ : tmp->right_;
+    }
+    Node *insertible = !node ? allocator_.Allocate(key) : node;
+    Link(insertible, parent, tmp, order);
+    return iterator(insertible);
+  };
+
+  // Ranked trees only: the number of elements less than key.
+  template <class K>
+  size_type Rank(const K &key) {
+    static_assert(Ranked, "rank needs an order-statistic tree");
+    size_type rank = 0;
+    Node *tmp = root_;
+    while (IsNode(tmp)) {
+      if (comparator.LessThan(tmp->data_, key)) {
+        rank += Size(tmp->left_) + 1;
+        tmp = tmp->right_;
+      } else {
+        tmp = tmp->left_;
+      }
+    }
+    return rank;
+  };
+
+  static size_type Size(Node *node) { return node ? node->subtree_size_ : 0; };
+
+  // The node of the given in-order rank below root. Ranks outside the tree
+  // give the nil sentinels.
+  static Node *Select(Node *root, long long rank) {
+    Node *node = root;
+    if (rank < 0) {
+      while (Size(node->left_)) node = node->left_;
+      node = node->left_;
+    } else if (rank >= static_cast<long long>(Size(root))) {
+      while (Size(node->right_)) node = node->right_;
+      node = node->right_;
+    } else {
+      while (rank != static_cast<long long>(Size(node->left_))) {
+        if (rank < static_cast<long long>(Size(node->left_))) {
+          node = node->left_;
+        } else {
+          rank -= Size(node->left_) + 1;
+          node = node->right_;
+        }
+      }
+    }
+    return node;
+  };
+
+  void ShrinkPath(Node *from) {
+    for (; from; from = from->parent_) --from->subtree_size_;
+  };
+
+  // Builds a balanced tree from sorted unique input in O(n). Nodes on the
+  // last, incomplete level are red, all the others are black.
+  template <class ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last) {
+    clear();
+    size_type count = std::distance(first, last);
+    if (count) {
+      size_type red_depth = 0;
+      while ((size_type(2) << red_depth) <= count + 1) ++red_depth;
+      auto next_node = [&] {
+        Node *node = allocator_.Allocate(*first);
+        ++first;
+        return node;
+      };
+      root_ = BuildSorted(next_node, count, 0, red_depth);
+      root_->parent_ = nullptr;
+      AttachNils();
+      size_ = count;
+    }
+  };
+
+  // Builds this empty tree, like AssignSorted, from count nodes chained in
+  // ascending order through their left_ links.
+  void AssignChain(Node *chain, size_type count) {
+    if (count) {
+      size_type red_depth = 0;
+      while ((size_type(2) << red_depth) <= count + 1) ++red_depth;
+      auto next_node = [&] {
+        Node *node = chain;
+        chain = chain->left_;
+        return node;
+      };
+      root_ = BuildSorted(next_node, count, 0, red_depth);
+      root_->parent_ = nullptr;
+      AttachNils();
+      size_ = count;
+    }
+  };
+
+  // Takes the nodes for the tree, in order, from next_node().
+  template <class NextNode>
+  Node *BuildSorted(NextNode &next_node, size_type count, size_type depth,
+                    size_type red_depth) {
+    if (!count) return nullptr;
+    Node *left = BuildSorted(next_node, count / 2, depth + 1, red_depth);
+    Node *node = next_node();
+    node->red_ = depth == red_depth;
+    node->left_ = left;
+    if (left) left->parent_ = node;
+    node->right_ = BuildSorted(next_node, count - count / 2 - 1, depth + 1,
+                               red_depth);
+    if (node->right_) node->right_->parent_ = node;
+    if constexpr (Ranked) node->subtree_size_ = count;
+    return node;
+  };
+
+  // Copies the shape, colours and elements of other into this empty tree.
+  void CloneFrom(const BinaryTree &other) {
+    if (other.root_) {
+      root_ = CloneSubtree(other, other.root_, nullptr);
+      AttachNils();
+      size_ = other.size_;
+    }
+  };
+
+  Node *CloneSubtree(const BinaryTree &other, Node *source, Node *parent) {
+    if (!other.IsNode(source)) return nullptr;
+    Node *copy = allocator_.Allocate(source->data_);
+    copy->red_ = source->red_;
+    copy->parent_ = parent;
+    if constexpr (Ranked) copy->subtree_size_ = source->subtree_size_;
+    copy->left_ = CloneSubtree(other, source->left_, copy);
+    copy->right_ = CloneSubtree(other, source->right_, copy);
+    return copy;
+  };
+
+  // Hangs the nil sentinels off the extreme nodes of a freshly built tree.
+  void AttachNils() {
+    Node *min = GetMin(root_);
+    Node *max = GetMax(root_);
+    min->left_ = begin_nil_;
+    begin_nil_->parent_ = min;
+    begin_nil_->left_ = begin_nil_;
+    max->right_ = end_nil_;
+    end_nil_->parent_ = max;
+    end_nil_->right_ = end_nil_;
+  };
+
+  // Empties the tree without freeing its nodes. Returns them chained in
+  // ascending order through their left_ links; Next only follows right_
+  // links upwards, so the walk survives the relinking.
+  Node *DetachChain() {
+    Node *head = nullptr;
+    Node **tail = &head;
+    if (root_) {
+      for (Node *node = begin_nil_->parent_; node != end_nil_;) {
+        Node *next = Next(node);
+        *tail = node;
+        tail = &node->left_;
+        node = next;
+      }
+      *tail = nullptr;
+      DeleteRoot();
+      size_ = 0;
+    }
+    return head;
+  };
+
+  static size_type ChainLength(Node *chain) {
+    size_type count = 0;
+    for (; chain; chain = chain->left_) ++count;
+    return count;
+  };
+
+  // Set algebra in O(n + m): walks this tree and other in order together and
+  // rebuilds this tree from the nodes that survive. The keep flags tell
+  // whether elements found only here, in both trees or only in other stay.
+  // Nodes of this tree are reused; elements taken from other are copied.
+  // The whole tree is rebuilt, so this pays off when other is not tiny.
+  // Combined with itself, every element is common to both trees.
+  void Combine(const BinaryTree &other, bool keep_own, bool keep_common,
+               bool keep_other) {
+    if (&other == this) {
+      if (!keep_common) clear();
+      return;
+    }
+    Node *own = DetachChain();
+    Node *theirs = other.root_ ? other.begin_nil_->parent_ : other.end_nil_;
+    Node *head = nullptr;
+    Node **tail = &head;
+    size_type count = 0;
+    try {
+      while (own || theirs != other.end_nil_) {
+        int order = 1;
+        if (theirs == other.end_nil_) {
+          order = -1;
+        } else if (own) {
+          order = Order(own->data_, theirs->data_);
+        }
+        Node *kept = nullptr;
+        if (order <= 0) {
+          Node *node = own;
+          own = own->left_;
+          if (order < 0 ? keep_own : keep_common) {
+            kept = node;
+          } else {
+            allocator_.Deallocate(node);
+          }
+        }
+        if (order >= 0) {
+          if (order > 0 && keep_other)
+            kept = allocator_.Allocate(theirs->data_);
+          theirs = Next(theirs);
+        }
+        if (kept) {
+          *tail = kept;
+          tail = &kept->left_;
+          ++count;
+        }
+      }
+    } catch (...) {
+      *tail = own;
+      AssignChain(head, count + ChainLength(own));
+      throw;
+    }
+    *tail = nullptr;
+    AssignChain(head, count);
+  };
+
+  // Moves the elements missing here out of other in O(n + m). Nodes are
+  // relinked when this tree's allocator is able to free them later;
+  // otherwise their elements move into new nodes. other keeps the elements
+  // both trees have. With keep_equal everything moves, equal elements after
+  // the ones here. An absorb function instead folds each element of other
+  // into the equal one here, as absorb(own, theirs), and frees its node.
+  template <class Absorb = std::nullptr_t>
+  void MergeFrom(BinaryTree &other, bool keep_equal = false,
+                 Absorb absorb = nullptr) {
+    Node *own = DetachChain();
+    Node *theirs = other.DetachChain();
+    Node *head = nullptr, *rest = nullptr;
+    Node **tail = &head, **rest_tail = &rest;
+    size_type count = 0, rest_count = 0;
+    while (own || theirs) {
+      int order = 1;
+      if (!theirs) {
+        order = -1;
+      } else if (own) {
+        order = Order(own->data_, theirs->data_);
+        if (!order && keep_equal) order = -1;
+      }
+      Node *kept = nullptr;
+      if (order <= 0) {
+        kept = own;
+        own = own->left_;
+      }
+      if (!order) {
+        Node *node = theirs;
+        theirs = theirs->left_;
+        if constexpr (std::is_same<Absorb, std::nullptr_t>::value) {
+          *rest_tail = node;
+          rest_tail = &node->left_;
+          ++rest_count;
+        } else {
+          absorb(kept->data_, node->data_);
+          other.allocator_.Deallocate(node);
+        }
+      } else if (order > 0) {
+        kept = theirs;
+        if constexpr (!Allocator<Node>::kIsAlwaysEqual) {
+          try {
+            kept = allocator_.Allocate(std::move(theirs->data_));
+          } catch (...) {
+            *tail = own;
+            *rest_tail = theirs;
+            AssignChain(head, count + ChainLength(own));
+            other.AssignChain(rest, rest_count + ChainLength(theirs));
+            throw;
+          }
+        }
+        Node *node = theirs;
+        theirs = theirs->left_;
+        if (kept != node) other.allocator_.Deallocate(node);
+      }
+      *tail = kept;
+      tail = &kept->left_;
+      ++count;
+    }
+    *tail = nullptr;
+    *rest_tail = nullptr;
+    AssignChain(head, count);
+    other.AssignChain(rest, rest_count);
+  };
+
+  // Hangs a detached node into the empty slot where Search stopped; order is
+  // the result of the last comparison Search made.
+  void Link(Node *insertible, Node *parent, Node *slot, int order) {
+    if constexpr (Ranked) insertible->subtree_size_ = 1;
     if (!root_) {
       root_ = insertible;
+      insertible->parent_ = nullptr;
+      insertible->red_ = false;
       insertible->right_ = end_nil_;
       insertible->left_ = begin_nil_;
       end_nil_->parent_ = insertible;
@@ -335,42 +846,146 @@ class BinaryTree {
       end_nil_->right_ = end_nil_;
       begin_nil_->left_ = begin_nil_;
     } else {
-      Node *tmp = root_;
-      Node *parent = Search(key, tmp);
-      if (tmp == end_nil_) {
+      if (slot == end_nil_) {
         parent->right_ = insertible;
-        insertible->parent_ = parent;
         insertible->left_ = nullptr;
         insertible->right_ = end_nil_;
         end_nil_->parent_ = insertible;
-      } else if (tmp == begin_nil_) {
+      } else if (slot == begin_nil_) {
         parent->left_ = insertible;
-        insertible->parent_ = parent;
-        insertible->left_ = nullptr;
         insertible->left_ = begin_nil_;
+        insertible->right_ = nullptr;
         begin_nil_->parent_ = insertible;
-      } else if (!tmp) {
-        comparator.LessThan(key, parent->data_) ? parent->left_ = insertible
-                                                : parent->right_ = insertible;
-        insertible->parent_ = parent;
+      } else {
+        order < 0 ? parent->left_ = insertible : parent->right_ = insertible;
         insertible->left_ = insertible->right_ = nullptr;
+      }
+      insertible->parent_ = parent;
+      insertible->red_ = true;
+      if constexpr (Ranked)
+        for (Node *tmp = parent; tmp; tmp = tmp->parent_) ++tmp->subtree_size_;
+      InsertFixup(insertible);
+    }
+    ++size_;
+  };
+
+  // The slot is made first, so that a node is never lost to a throwing
+  // push_back; a failed Allocate leaves it null.
+  template <class Arg>
+  void AllocateInto(std::vector<Node *> &nodes, Arg &&arg) {
+    nodes.push_back(nullptr);
+    nodes.back() = allocator_.Allocate(std::forward<Arg>(arg));
+  };
+
+  std::vector<std::pair<iterator, bool>> InsertBatch(
+      const std::vector<Node *> &nodes, bool unique) {
+    std::vector<size_type> sorted;
+    std::vector<std::pair<iterator, bool>> results;
+    try {
+      sorted.resize(nodes.size());
+      results.resize(nodes.size());
+    } catch (...) {
+      for (Node *node : nodes) allocator_.Deallocate(node);
+      throw;
+    }
+    for (size_type i = 0; i < sorted.size(); ++i) sorted[i] = i;
+    auto less = [&](size_type a, size_type b) {
+      return Order(nodes[a]->data_, nodes[b]->data_) < 0;
+    };
+    if (!std::is_sorted(sorted.begin(), sorted.end(), less))
+      std::stable_sort(sorted.begin(), sorted.end(), less);
+    // Rebuilding visits every node, which only pays off against a tree no
+    // larger than the batch.
+    if (size_ <= nodes.size()) {
+      MergeBatch(nodes, sorted, unique, results);
+    } else {
+      PlaceBatch(nodes, sorted, unique, results);
+    }
+    return results;
+  };
+
+  // Rebuilds the tree from its nodes and the sorted batch in O(n + m).
+  void MergeBatch(const std::vector<Node *> &nodes,
+                  const std::vector<size_type> &sorted, bool unique,
+                  std::vector<std::pair<iterator, bool>> &results) {
+    Node *own = DetachChain();
+    Node *head = nullptr;
+    Node **tail = &head;
+    Node *last = nullptr;
+    size_type count = 0;
+    auto keep = [&](Node *node) {
+      *tail = last = node;
+      tail = &node->left_;
+      ++count;
+    };
+    for (size_type i : sorted) {
+      Node *node = nodes[i];
+      while (own && Order(own->data_, node->data_) <= 0) {
+        Node *next = own->left_;
+        keep(own);
+        own = next;
+      }
+      if (unique && last && !Order(node->data_, last->data_)) {
+        allocator_.Deallocate(node);
+        results[i] = std::pair<iterator, bool>(iterator(last), false);
+      } else {
+        keep(node);
+        results[i] = std::pair<iterator, bool>(iterator(node), true);
+      }
+    }
+    *tail = own;
+    AssignChain(head, count + ChainLength(own));
+  };
+
+  // Links the sorted batch in one node at a time, each search climbing
+  // from the previous insertion point.
+  void PlaceBatch(const std::vector<Node *> &nodes,
+                  const std::vector<size_type> &sorted, bool unique,
+                  std::vector<std::pair<iterator, bool>> &results) {
+    Node *last = nullptr;
+    for (size_type i : sorted) {
+      Node *node = nodes[i];
+      Node *slot = last ? Climb(last, node->data_) : root_;
+      Node *parent = nullptr;
+      int order = 0;
+      if (unique) {
+        parent = Search(node->data_, slot, order);
       } else {
-        pair.first = iterator(tmp);
-        pair.second = false;
-        if (!node) delete insertible;
+        while (IsNode(slot)) {
+          parent = slot;
+          order = Order(node->data_, slot->data_) < 0 ? -1 : 1;
+          slot = order < 0 ? slot->left_ : slot->right_;
+        }
+      }
+      if (IsNode(slot)) {
+        allocator_.Deallocate(node);
+        results[i] = std::pair<iterator, bool>(iterator(slot), false);
+        last = slot;
+      } else {
+        Link(node, parent, slot, order);
+        results[i] = std::pair<iterator, bool>(iterator(node), true);
+        last = node;
       }
     }
-    if (pair.second) ++size_;
-    return pair;
   };
 
-  void DeleteLeaf(Node *leaf) {
-    ChangeParentsChild(leaf->parent_, leaf, nullptr);
+  // The lowest ancestor of node whose subtree takes key, for a key not less
+  // than the element of node: climbs past right children, and past left
+  // children whose parent is not greater than key.
+  template <class K>
+  Node *Climb(Node *node, const K &key) {
+    while (node->parent_ && (node == node->parent_->right_ ||
+                             Order(key, node->parent_->data_) >= 0))
+      node = node->parent_;
+    return node;
   };
 
-  void DeleteWithChild(Node *node, Node *child) {
-    ChangeParentsChild(node->parent_, node, child);
-    child->parent_ = node->parent_;
+  void DestroySubtree(Node *node) {
+    if (IsNode(node)) {
+      DestroySubtree(node->left_);
+      DestroySubtree(node->right_);
+      allocator_.Discard(node);
+    }
   };
 
   void DeleteRoot() {
@@ -379,117 +994,371 @@ class BinaryTree {
     end_nil_->parent_ = begin_nil_;
   };
 
-  void DeleteWithWwo(Node *node, Node *parent) {
-    Node *max_in_left = GetMax(node->left_);
-    Node *parent_moved = max_in_left->parent_;
-    if (parent_moved == node) {
-      max_in_left->right_ = node->right_;
-      node->right_->parent_ = max_in_left;
-      max_in_left->parent_ = parent;
-      if (parent) {
-        ChangeParentsChild(parent, node, max_in_left);
-      } else {
-        root_ = max_in_left;
-      }
+  // Red-black balancing. Nil sentinels are black and always stay attached to
+  // the minimum and maximum nodes: rotations never move the leftmost left
+  // child or the rightmost right child, so they need no special handling.
+  bool IsRed(Node *node) const { return node && node->red_; };
+
+  void RotateLeft(Node *node) {
+    Node *child = node->right_;
+    node->right_ = child->left_;
+    if (child->left_) child->left_->parent_ = node;
+    child->parent_ = node->parent_;
+    if (node->parent_) {
+      ChangeParentsChild(node->parent_, node, child);
     } else {
-      parent_moved->right_ = max_in_left->left_;
-      if (max_in_left->left_) parent_moved->right_->parent_ = parent_moved;
-      max_in_left->left_ = node->left_;
-      node->left_->parent_ = max_in_left;
-      max_in_left->parent_ = parent;
-      if (parent) {
-        ChangeParentsChild(parent, node, max_in_left);
-      } else {
-        root_ = max_in_left;
-      }
-      max_in_left->right_ = node->right_;
-      node->right_->parent_ = max_in_left;
+      root_ = child;
+    }
+    child->left_ = node;
+    node->parent_ = child;
+    if constexpr (Ranked) {
+      child->subtree_size_ = node->subtree_size_;
+      node->subtree_size_ = 1 + Size(node->left_) + Size(node->right_);
     }
   };
 
-  void DeleteWithNilInLeft(Node *node, Node *parent) {
-    if (!node->right_->left_) {
-      node->right_->parent_ = parent;
-      if (parent) {
-        ChangeParentsChild(parent, node, node->right_);
-      } else {
-        root_ = node->right_;
-      }
-      node->right_->left_ = begin_nil_;
-      begin_nil_->parent_ = node->right_;
+  void RotateRight(Node *node) {
+    Node *child = node->left_;
+    node->left_ = child->right_;
+    if (child->right_) child->right_->parent_ = node;
+    child->parent_ = node->parent_;
+    if (node->parent_) {
+      ChangeParentsChild(node->parent_, node, child);
     } else {
-      Node *min_in_right = GetMin(node->right_);
-      Node *tmp = min_in_right->right_;
-      Node *parent_moved = min_in_right->parent_;
-      parent_moved->left_ = tmp;
-      if (tmp) tmp->parent_ = parent_moved;
-      min_in_right->parent_ = parent;
-      if (parent) {
-        ChangeParentsChild(parent, node, min_in_right);
+      root_ = child;
+    }
+    child->right_ = node;
+    node->parent_ = child;
+    if constexpr (Ranked) {
+      child->subtree_size_ = node->subtree_size_;
+      node->subtree_size_ = 1 + Size(node->left_) + Size(node->right_);
+    }
+  };
+
+  void InsertFixup(Node *node) {
+    while (IsRed(node->parent_)) {
+      Node *parent = node->parent_;
+      Node *grand = parent->parent_;
+      if (parent == grand->left_) {
+        Node *uncle = grand->right_;
+        if (IsRed(uncle)) {
+          parent->red_ = uncle->red_ = false;
+          grand->red_ = true;
+          node = grand;
+        } else {
+          if (node == parent->right_) {
+            node = parent;
+            RotateLeft(node);
+            parent = node->parent_;
+          }
+          parent->red_ = false;
+          grand->red_ = true;
+          RotateRight(grand);
+        }
       } else {
-        root_ = min_in_right;
+        Node *uncle = grand->left_;
+        if (IsRed(uncle)) {
+          parent->red_ = uncle->red_ = false;
+          grand->red_ = true;
+          node = grand;
+        } else {
+          if (node == parent->left_) {
+            node = parent;
+            RotateRight(node);
+            parent = node->parent_;
+          }
+          parent->red_ = false;
+          grand->red_ = true;
+          RotateLeft(grand);
+        }
       }
-      min_in_right->right_ = node->right_;
-      node->right_->parent_ = min_in_right;
-      begin_nil_->parent_ = min_in_right;
-      min_in_right->left_ = begin_nil_;
     }
+    root_->red_ = false;
+  };
+
+  void Transplant(Node *old_node, Node *new_node) {
+    if (old_node->parent_) {
+      ChangeParentsChild(old_node->parent_, old_node, new_node);
+    } else {
+      root_ = new_node;
+    }
+    if (new_node) new_node->parent_ = old_node->parent_;
   };
 
-  void DeleteWithNilInRight(Node *node, Node *parent) {
-    if (!node->left_->right_) {
-      node->left_->parent_ = parent;
-      if (parent) {
-        ChangeParentsChild(parent, node, node->left_);
+  // Expects the nil sentinels to be detached from node beforehand.
+  void Unlink(Node *node) {
+    Node *moved = node;
+    bool moved_red = moved->red_;
+    Node *child = nullptr;
+    Node *parent = nullptr;
+    if (!node->left_) {
+      if constexpr (Ranked) ShrinkPath(node->parent_);
+      child = node->right_;
+      parent = node->parent_;
+      Transplant(node, node->right_);
+    } else if (!node->right_) {
+      if constexpr (Ranked) ShrinkPath(node->parent_);
+      child = node->left_;
+      parent = node->parent_;
+      Transplant(node, node->left_);
+    } else {
+      moved = GetMin(node->right_);
+      moved_red = moved->red_;
+      if constexpr (Ranked) ShrinkPath(moved->parent_);
+      child = moved->right_;
+      if (moved->parent_ == node) {
+        parent = moved;
       } else {
-        root_ = node->left_;
+        parent = moved->parent_;
+        Transplant(moved, moved->right_);
+        moved->right_ = node->right_;
+        moved->right_->parent_ = moved;
       }
-      node->left_->right_ = end_nil_;
-      end_nil_->parent_ = node->left_;
-    } else {
-      Node *max_in_left = GetMax(node->left_);
-      Node *tmp = max_in_left->left_;
-      Node *parent_moved = max_in_left->parent_;
-      parent_moved->right_ = tmp;
-      if (tmp) tmp->parent_ = parent_moved;
-      max_in_left->parent_ = parent;
-      if (parent) {
-        ChangeParentsChild(parent, node, max_in_left);
+      Transplant(node, moved);
+      moved->left_ = node->left_;
+      moved->left_->parent_ = moved;
+      moved->red_ = node->red_;
+      if constexpr (Ranked) moved->subtree_size_ = node->subtree_size_;
+    }
+    if (!moved_red) DeleteFixup(child, parent);
+  };
+
+  void DeleteFixup(Node *node, Node *parent) {
+    while (node != root_ && !IsRed(node)) {
+      if (node == parent->left_) {
+        Node *sibling = parent->right_;
+        if (IsRed(sibling)) {
+          sibling->red_ = false;
+          parent->red_ = true;
+          RotateLeft(parent);
+          sibling = parent->right_;
+        }
+        if (!IsRed(sibling->left_) && !IsRed(sibling->right_)) {
+          sibling->red_ = true;
+          node = parent;
+          parent = node->parent_;
+        } else {
+          if (!IsRed(sibling->right_)) {
+            sibling->left_->red_ = false;
+            sibling->red_ = true;
+            RotateRight(sibling);
+            sibling = parent->right_;
+          }
+          sibling->red_ = parent->red_;
+          parent->red_ = false;
+          sibling->right_->red_ = false;
+          RotateLeft(parent);
+          node = root_;
+        }
       } else {
-        root_ = max_in_left;
+        Node *sibling = parent->left_;
+        if (IsRed(sibling)) {
+          sibling->red_ = false;
+          parent->red_ = true;
+          RotateRight(parent);
+          sibling = parent->left_;
+        }
+        if (!IsRed(sibling->left_) && !IsRed(sibling->right_)) {
+          sibling->red_ = true;
+          node = parent;
+          parent = node->parent_;
+        } else {
+          if (!IsRed(sibling->left_)) {
+            sibling->right_->red_ = false;
+            sibling->red_ = true;
+            RotateLeft(sibling);
+            sibling = parent->left_;
+          }
+          sibling->red_ = parent->red_;
+          parent->red_ = false;
+          sibling->left_->red_ = false;
+          RotateRight(parent);
+          node = root_;
+        }
       }
-      max_in_left->left_ = node->left_;
-      node->left_->parent_ = max_in_left;
-      end_nil_->parent_ = max_in_left;
-      max_in_left->right_ = end_nil_;
     }
+    if (node) node->red_ = false;
+  };
+
+  template <class L, class R>
+  int Order(const L &a, const R &b) const {
+    return s21::Order(comparator, a, b);
   };
 
-  Node *Search(const key_type &key, Node *&tmp_node) {
+  // Lookups are templated on the probe type: with a transparent comparator
+  // any type comparable with the stored elements can be searched for. The
+  // descent makes one comparison per level and leaves its last result in
+  // order.
+  template <class K>
+  Node *Search(const K &key, Node *&tmp_node, int &order) {
     Node *parent = nullptr;
-    while (tmp_node != nullptr && tmp_node != end_nil_ &&
-           comparator.NotEquals(key, tmp_node->data_) &&
-           tmp_node != begin_nil_) {
+    order = 0;
+    while (IsNode(tmp_node) && (order = Order(key, tmp_node->data_))) {
       parent = tmp_node;
-      if (comparator.LessThan(key, tmp_node->data_))
-        tmp_node = tmp_node->left_;
-      else if (comparator.GreaterThan(key, tmp_node->data_))
-        tmp_node = tmp_node->right_;
+      tmp_node = order < 0 ? tmp_node->left_ : tmp_node->right_;
     }
     return parent;
   };
 
-  bool IsLeaf(Node *checked) {
-    bool tmp = false;
-    if (checked->left_ == nullptr && checked->right_ == nullptr) tmp = true;
-    return tmp;
+  template <class K>
+  Node *Search(const K &key, Node *&tmp_node) {
+    int order = 0;
+    return Search(key, tmp_node, order);
   };
 
-  Node *HasOneChild(Node *checked) {
-    Node *tmp = nullptr;
-    if (checked->left_ && !checked->right_) tmp = checked->left_;
-    if (!checked->left_ && checked->right_) tmp = checked->right_;
-    return tmp;
+  // Search that starts from hint. When key belongs right before or right
+  // after hint, only hint and its neighbour are compared, and stepping to
+  // the neighbour is amortised O(1). Otherwise searches from the root.
+  template <class K>
+  Node *SearchNear(Node *hint, const K &key, Node *&tmp_node, int &order) {
+    if (root_ && (IsNode(hint) || hint == end_nil_)) {
+      order = hint == end_nil_ ? -1 : Order(key, hint->data_);
+      if (!order) {
+        tmp_node = hint;
+        return hint->parent_;
+      }
+      Node *near = order < 0 ? Prev(hint) : Next(hint);
+      int near_order = IsNode(near) ? Order(key, near->data_) : -order;
+      if (!near_order) {
+        tmp_node = near;
+        return near->parent_;
+      }
+      if (near_order != order) {
+        Node *before = order < 0 ? near : hint;
+        Node *after = order < 0 ? hint : near;
+        Node *slot = IsNode(before) ? before->right_ : begin_nil_;
+        if (!slot || slot == end_nil_) {
+          tmp_node = slot;
+          order = 1;
+          return before;
+        }
+        tmp_node = after->left_;
+        order = -1;
+        return after;
+      }
+    }
+    tmp_node = root_;
+    return Search(key, tmp_node, order);
+  };
+
+  bool IsNode(Node *checked) const {
+    return checked && checked != end_nil_ && checked != begin_nil_;
+  };
+
+  template <class K>
+  Node *Find(const K &key) {
+    Node *tmp = root_;
+    Search(key, tmp);
+    return IsNode(tmp) ? tmp : nullptr;
+  };
+
+  // A lookup of FindMany: its key, held by reference while the iterator
+  // can come back to it and copied otherwise, and what probe makes of it,
+  // computed once as the lane is loaded. Lanes are built in place and never
+  // move, so probed may refer to key.
+  template <class Held, class Probe>
+  struct LookupLane {
+    template <class K>
+    LookupLane(K &&from, Probe &probe)
+        : key(std::forward<K>(from)), probed(probe(key)){};
+
+    Held key;
+    decltype(std::declval<Probe &>()(std::declval<Held &>())) probed;
+  };
+
+  // Looks up the keys of [first, last) kLookupGroup at a time. The lookups
+  // of a group descend together, one level per round, and each fetches its
+  // next node ahead of the round that reads it, so the cache misses of the
+  // group overlap instead of following one another. emit gets the node of
+  // each key in order, or nullptr for a missing one. probe turns a key
+  // into what the comparator accepts.
+  template <class InputIt, class Probe, class Emit>
+  void FindMany(InputIt first, InputIt last, Probe probe, Emit emit) {
+    using traits = std::iterator_traits<InputIt>;
+    using reference = decltype(*first);
+    constexpr bool kKeepsKeys =
+        std::is_lvalue_reference<reference>::value &&
+        std::is_base_of<std::forward_iterator_tag,
+                        typename traits::iterator_category>::value;
+    using held = std::conditional_t<kKeepsKeys, reference,
+                                    typename traits::value_type>;
+    std::optional<LookupLane<held, Probe>> lanes[kLookupGroup];
+    Node *nodes[kLookupGroup];
+    bool found[kLookupGroup];
+    while (first != last) {
+      size_type count = 0;
+      for (; count < kLookupGroup && first != last; ++first, ++count) {
+        lanes[count].emplace(*first, probe);
+        nodes[count] = root_;
+        found[count] = false;
+      }
+      for (bool active = true; active;) {
+        active = false;
+        for (size_type i = 0; i < count; ++i) {
+          Node *node = nodes[i];
+          if (found[i] || !IsNode(node)) continue;
+          int order = Order(lanes[i]->probed, node->data_);
+          if (!order) {
+            found[i] = true;
+          } else {
+            node = order < 0 ? node->left_ : node->right_;
+            nodes[i] = node;
+            Prefetch(node);
+            active = true;
+          }
+        }
+      }
+      for (size_type i = 0; i < count; ++i)
+        emit(found[i] ? nodes[i] : nullptr);
+    }
+  };
+
+  // First node not less than key, or end_nil_.
+  template <class K>
+  Node *LowerBound(const K &key) {
+    Node *bound = end_nil_;
+    Node *tmp = root_;
+    while (IsNode(tmp)) {
+      if (comparator.LessThan(tmp->data_, key)) {
+        tmp = tmp->right_;
+      } else {
+        bound = tmp;
+        tmp = tmp->left_;
+      }
+    }
+    return bound;
+  };
+
+  // First node greater than key, or end_nil_.
+  template <class K>
+  Node *UpperBound(const K &key) {
+    Node *bound = end_nil_;
+    Node *tmp = root_;
+    while (IsNode(tmp)) {
+      if (comparator.LessThan(key, tmp->data_)) {
+        bound = tmp;
+        tmp = tmp->left_;
+      } else {
+        tmp = tmp->right_;
+      }
+    }
+    return bound;
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> EqualRange(const K &key) {
+    iterator first(LowerBound(key));
+    iterator last = first;
+    if (first != end() && !comparator.LessThan(key, *first)) ++last;
+    return std::pair<iterator, iterator>(first, last);
+  };
+
+  static void Prefetch(const Node *node) {
+#ifdef __GNUC__
+    __builtin_prefetch(node);
+#else
+    (void)node;
+#endif
   };
 
   Node *GetMax(Node *starting) {
@@ -497,7 +1366,7 @@ class BinaryTree {
   };
 
   Node *GetMin(Node *starting) {
-    return starting->left_ == nullptr ? starting : GetMax(starting->left_);
+    return starting->left_ == nullptr ? starting : GetMin(starting->left_);
   };
 };
 
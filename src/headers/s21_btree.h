@@ -0,0 +1,668 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_BTREE_H_
+#define S21_CONTAINERS_HEADERS_S21_BTREE_H_
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "s21_comparators.h"
+
+// B-tree keeping many elements per node, so that a lookup touches one node
+// per level instead of one per comparison. Nodes are sized to about
+// kTargetNodeBytes of elements. Elements live in every node; a non-root node
+// holds between kMinValues and kMaxValues of them. Any insertion or erasure
+// invalidates all iterators.
+template <class Key, class Compare = s21::SingleComp<Key>>
+class BTree {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = key_type &;
+  using const_reference = const key_type &;
+  using size_type = size_t;
+
+  static constexpr size_type kTargetNodeBytes = 256;
+  static constexpr int kMaxValues =
+      std::max<int>(4, std::min<int>(64, kTargetNodeBytes / sizeof(Key)));
+  static constexpr int kMinValues = kMaxValues / 2;
+
+  // values_ is raw storage: the first count_ slots hold elements, which
+  // are constructed and destroyed one by one as they come and go. The slot
+  // past kMaxValues takes the element that overfills a node before it
+  // splits.
+  struct Node {
+    Node(){};
+    ~Node() { std::destroy(values_, values_ + count_); };
+
+    Node *parent_ = nullptr;
+    int position_ = 0;
+    int count_ = 0;
+    bool leaf_ = true;
+    union {
+      key_type values_[kMaxValues + 1];
+    };
+  };
+
+  struct InnerNode : Node {
+    InnerNode() { this->leaf_ = false; };
+
+    Node *children_[kMaxValues + 2];
+  };
+
+  static Node *Child(Node *node, int index) {
+    return static_cast<InnerNode *>(node)->children_[index];
+  };
+
+  // In-order neighbours of the element at (node, position). The position
+  // past the last element of the root is end().
+  static void Next(Node *&node, int &position) {
+    if (!node->leaf_) {
+      node = Child(node, position + 1);
+      while (!node->leaf_) node = Child(node, 0);
+      position = 0;
+    } else {
+      ++position;
+      while (position == node->count_ && node->parent_) {
+        position = node->position_;
+        node = node->parent_;
+      }
+    }
+  };
+
+  static void Prev(Node *&node, int &position) {
+    if (!node->leaf_) {
+      node = Child(node, position);
+      while (!node->leaf_) node = Child(node, node->count_);
+      position = node->count_ - 1;
+    } else {
+      while (!position && node->parent_) {
+        position = node->position_;
+        node = node->parent_;
+      }
+      --position;
+    }
+  };
+
+  class Iterator {
+   public:
+    Iterator() : node_(nullptr), position_(0){};
+    Iterator(Node *node, int position) : node_(node), position_(position){};
+
+    Node *node() const { return node_; };
+    int position() const { return position_; };
+
+    value_type &operator*() const { return node_->values_[position_]; };
+
+    Iterator &operator++() {
+      Next(node_, position_);
+      return *this;
+    };
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    Iterator &operator--() {
+      Prev(node_, position_);
+      return *this;
+    };
+
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    };
+
+    bool operator==(const Iterator &other) const {
+      return node_ == other.node_ && position_ == other.position_;
+    };
+
+    bool operator!=(const Iterator &other) const { return !(*this == other); };
+
+   private:
+    Node *node_;
+    int position_;
+  };
+
+  class ConstIterator {
+   public:
+    ConstIterator() : node_(nullptr), position_(0){};
+    ConstIterator(Node *node, int position)
+        : node_(node), position_(position){};
+    ConstIterator(const Iterator &other)
+        : node_(other.node()), position_(other.position()){};
+
+    const_reference operator*() const { return node_->values_[position_]; };
+
+    ConstIterator &operator++() {
+      Next(node_, position_);
+      return *this;
+    };
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    ConstIterator &operator--() {
+      Prev(node_, position_);
+      return *this;
+    };
+
+    ConstIterator operator--(int) {
+      ConstIterator tmp = *this;
+      --*this;
+      return tmp;
+    };
+
+    bool operator==(const ConstIterator &other) const {
+      return node_ == other.node_ && position_ == other.position_;
+    };
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    };
+
+   private:
+    Node *node_;
+    int position_;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  BTree(){};
+
+  BTree(const BTree &other) {
+    if (other.root_) root_ = CloneSubtree(other.root_, nullptr);
+    size_ = other.size_;
+  };
+
+  BTree(BTree &&other) { swap(other); };
+
+  ~BTree() { clear(); };
+
+  BTree &operator=(const BTree &other) {
+    if (this != &other) {
+      BTree copy(other);
+      swap(copy);
+    }
+    return *this;
+  };
+
+  BTree &operator=(BTree &&other) {
+    clear();
+    swap(other);
+    return *this;
+  };
+
+  iterator begin() {
+    if (!root_) return end();
+    Node *node = root_;
+    while (!node->leaf_) node = Child(node, 0);
+    return iterator(node, 0);
+  };
+
+  iterator end() { return iterator(root_, root_ ? root_->count_ : 0); };
+
+  const_iterator cbegin() const { return const_cast<BTree *>(this)->begin(); };
+
+  const_iterator cend() const { return const_cast<BTree *>(this)->end(); };
+
+  bool empty() const { return !size_; };
+
+  size_type size() const { return size_; };
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  };
+
+  void clear() {
+    DestroySubtree(root_);
+    root_ = nullptr;
+    size_ = 0;
+  };
+
+  // Returns the iterator following the erased element.
+  iterator erase(iterator pos) {
+    Node *node = pos.node();
+    int position = pos.position();
+    key_type erased = std::move(node->values_[position]);
+    if (!node->leaf_) {
+      Node *leaf = Child(node, position);
+      while (!leaf->leaf_) leaf = Child(leaf, leaf->count_);
+      node->values_[position] = std::move(leaf->values_[leaf->count_ - 1]);
+      node = leaf;
+      position = leaf->count_ - 1;
+      pos = iterator();
+    }
+    CloseSlot(node, position);
+    --size_;
+    if (Rebalance(node)) pos = iterator();
+    if (!root_) return end();
+    if (pos == iterator()) return iterator(LowerBound(erased));
+    while (position == node->count_ && node->parent_) {
+      position = node->position_;
+      node = node->parent_;
+    }
+    return iterator(node, position);
+  };
+
+  // Removes [first, last); a span covering the whole tree is cleared.
+  iterator erase(iterator first, iterator last) {
+    if (first == begin() && last == end()) {
+      clear();
+      return end();
+    }
+    size_type count = 0;
+    for (iterator it = first; it != last; ++it) ++count;
+    for (; count; --count) first = erase(first);
+    return first;
+  };
+
+  void swap(BTree &other) {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+  };
+
+ protected:
+  Node *root_ = nullptr;
+  size_type size_ = 0;
+  key_compare comparator;
+
+  template <class L, class R>
+  int Order(const L &a, const R &b) const {
+    return s21::Order(comparator, a, b);
+  };
+
+  // Binary search inside one node: the first index whose element is not less
+  // than key. found tells whether that element is equal to key.
+  template <class K>
+  int LowerIndex(Node *node, const K &key, bool &found) const {
+    int low = 0, high = node->count_;
+    found = false;
+    while (low < high) {
+      int middle = (low + high) / 2;
+      int order = Order(key, node->values_[middle]);
+      if (order > 0) {
+        low = middle + 1;
+      } else if (order < 0) {
+        high = middle;
+      } else {
+        found = true;
+        return middle;
+      }
+    }
+    return low;
+  };
+
+  template <class K>
+  int UpperIndex(Node *node, const K &key) const {
+    int low = 0, high = node->count_;
+    while (low < high) {
+      int middle = (low + high) / 2;
+      if (Order(key, node->values_[middle]) < 0) {
+        high = middle;
+      } else {
+        low = middle + 1;
+      }
+    }
+    return low;
+  };
+
+  template <class K>
+  iterator Find(const K &key) {
+    bool found = false;
+    for (Node *node = root_; node;) {
+      int index = LowerIndex(node, key, found);
+      if (found) return iterator(node, index);
+      if (node->leaf_) break;
+      node = Child(node, index);
+    }
+    return end();
+  };
+
+  template <class K>
+  iterator LowerBound(const K &key) {
+    iterator bound = end();
+    bool found = false;
+    for (Node *node = root_; node;) {
+      int index = LowerIndex(node, key, found);
+      if (index < node->count_) bound = iterator(node, index);
+      if (found || node->leaf_) break;
+      node = Child(node, index);
+    }
+    return bound;
+  };
+
+  template <class K>
+  iterator UpperBound(const K &key) {
+    iterator bound = end();
+    for (Node *node = root_; node;) {
+      int index = UpperIndex(node, key);
+      if (index < node->count_) bound = iterator(node, index);
+      if (node->leaf_) break;
+      node = Child(node, index);
+    }
+    return bound;
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> EqualRange(const K &key) {
+    iterator first = LowerBound(key);
+    iterator last = first;
+    if (first != end() && !Order(key, *first)) ++last;
+    return std::pair<iterator, iterator>(first, last);
+  };
+
+  // Inserts value unless an equal element exists; returns where it is.
+  // The nodes and the element are all made before the tree changes, so a
+  // throw from an allocation or from make leaves it as it was.
+  template <class K, class Make>
+  std::pair<iterator, bool> InsertUnique(const K &key, Make &&make) {
+    if (!root_) {
+      std::unique_ptr<Node> root(new Node);
+      new (root->values_) key_type(make());
+      root->count_ = 1;
+      root_ = root.release();
+      size_ = 1;
+      return std::pair<iterator, bool>(iterator(root_, 0), true);
+    }
+    Node *node = root_;
+    int index = 0;
+    bool found = false;
+    while (true) {
+      index = LowerIndex(node, key, found);
+      if (found) return std::pair<iterator, bool>(iterator(node, index), false);
+      if (node->leaf_) break;
+      node = Child(node, index);
+    }
+    Spares spares;
+    for (Node *full = node; full && full->count_ == kMaxValues;
+         full = full->parent_) {
+      spares.Add(full->leaf_ ? new Node : new InnerNode);
+      if (full == root_) spares.Add(new InnerNode);
+    }
+    InsertValue(node, index, make(), nullptr);
+    ++size_;
+    return std::pair<iterator, bool>(SplitOverflow(node, index, spares),
+                                     true);
+  };
+
+  // Nodes allocated ahead for the splits of one insertion, taken in the
+  // order they were added. Those left over are freed.
+  class Spares {
+   public:
+    Spares(){};
+    Spares(const Spares &other) = delete;
+    Spares &operator=(const Spares &other) = delete;
+    ~Spares() {
+      while (head_) DeleteNode(Take());
+    };
+
+    void Add(Node *node) {
+      *tail_ = node;
+      tail_ = &node->parent_;
+    };
+
+    Node *Take() {
+      Node *node = head_;
+      head_ = node->parent_;
+      node->parent_ = nullptr;
+      return node;
+    };
+
+   private:
+    Node *head_ = nullptr;
+    Node **tail_ = &head_;
+  };
+
+  // Moves the elements from index on one slot up, leaving index raw.
+  static void OpenSlot(Node *node, int index) {
+    key_type *values = node->values_;
+    int count = node->count_;
+    if (index == count) return;
+    new (values + count) key_type(std::move(values[count - 1]));
+    std::move_backward(values + index, values + count - 1, values + count);
+    values[index].~key_type();
+  };
+
+  // Destroys the element at index and moves the later ones one slot down.
+  static void CloseSlot(Node *node, int index) {
+    key_type *values = node->values_;
+    std::move(values + index + 1, values + node->count_, values + index);
+    values[--node->count_].~key_type();
+  };
+
+  // Moves count elements of source, from first on, into the raw slots of
+  // target from to on.
+  static void MoveSlots(Node *source, int first, int count, Node *target,
+                        int to) {
+    key_type *from = source->values_ + first;
+    std::uninitialized_move(from, from + count, target->values_ + to);
+    std::destroy(from, from + count);
+  };
+
+  // Shifts value (and, in inner nodes, the child to its right) into node.
+  void InsertValue(Node *node, int index, key_type &&value, Node *right) {
+    OpenSlot(node, index);
+    new (node->values_ + index) key_type(std::move(value));
+    if (right) {
+      Node **children = static_cast<InnerNode *>(node)->children_;
+      for (int i = node->count_ + 1; i > index + 1; --i) {
+        children[i] = children[i - 1];
+        children[i]->position_ = i;
+      }
+      children[index + 1] = right;
+      right->parent_ = node;
+      right->position_ = index + 1;
+    }
+    ++node->count_;
+  };
+
+  // Splits overfull nodes from node up to the root, with nodes taken from
+  // spares. Returns the new place of the element inserted at (node, index).
+  iterator SplitOverflow(Node *node, int index, Spares &spares) {
+    Node *tracked = node;
+    while (node->count_ > kMaxValues) {
+      int middle = node->count_ / 2;
+      key_type median = std::move(node->values_[middle]);
+      Node *right = Split(node, middle, spares.Take());
+      bool tracking_median = tracked == node && index == middle;
+      if (tracked == node && index > middle) {
+        tracked = right;
+        index -= middle + 1;
+      }
+      Node *parent = node->parent_;
+      if (!parent) {
+        InnerNode *root = static_cast<InnerNode *>(spares.Take());
+        root->children_[0] = node;
+        node->parent_ = root;
+        node->position_ = 0;
+        root_ = parent = root;
+      }
+      int position = node->position_;
+      InsertValue(parent, position, std::move(median), right);
+      if (tracking_median) {
+        tracked = parent;
+        index = position;
+      }
+      node = parent;
+    }
+    return iterator(tracked, index);
+  };
+
+  // Moves the elements after middle, with their children, to right, an
+  // empty node of the same kind. The element at middle, already moved out
+  // by the caller, is destroyed.
+  Node *Split(Node *node, int middle, Node *right) {
+    int count = node->count_ - middle - 1;
+    MoveSlots(node, middle + 1, count, right, 0);
+    right->count_ = count;
+    node->values_[middle].~key_type();
+    if (!node->leaf_) {
+      for (int i = 0; i <= right->count_; ++i) {
+        Node *child = Child(node, middle + 1 + i);
+        static_cast<InnerNode *>(right)->children_[i] = child;
+        child->parent_ = right;
+        child->position_ = i;
+      }
+    }
+    node->count_ = middle;
+    return right;
+  };
+
+  // Restores the minimum fill after an erasure from node, borrowing from or
+  // merging with siblings. Returns whether any element moved between nodes.
+  bool Rebalance(Node *node) {
+    bool moved = false;
+    while (node != root_ && node->count_ < kMinValues) {
+      moved = true;
+      Node *parent = node->parent_;
+      int index = node->position_;
+      Node *left = index > 0 ? Child(parent, index - 1) : nullptr;
+      Node *right = index < parent->count_ ? Child(parent, index + 1) : nullptr;
+      if (left && left->count_ > kMinValues) {
+        RotateRight(parent, index - 1);
+        break;
+      }
+      if (right && right->count_ > kMinValues) {
+        RotateLeft(parent, index);
+        break;
+      }
+      Merge(parent, left ? index - 1 : index);
+      node = parent;
+    }
+    if (!root_->count_) {
+      Node *old_root = root_;
+      root_ = root_->leaf_ ? nullptr : Child(root_, 0);
+      if (root_) root_->parent_ = nullptr;
+      DeleteNode(old_root);
+      moved = true;
+    }
+    return moved;
+  };
+
+  // Moves the last element of child index up into the parent and the
+  // separator down into the front of child index + 1.
+  void RotateRight(Node *parent, int index) {
+    Node *left = Child(parent, index);
+    Node *right = Child(parent, index + 1);
+    Node *moved_child =
+        left->leaf_ ? nullptr : Child(left, left->count_);
+    OpenSlot(right, 0);
+    new (right->values_) key_type(std::move(parent->values_[index]));
+    parent->values_[index] = std::move(left->values_[left->count_ - 1]);
+    left->values_[left->count_ - 1].~key_type();
+    if (moved_child) {
+      Node **children = static_cast<InnerNode *>(right)->children_;
+      for (int i = right->count_ + 1; i > 0; --i) {
+        children[i] = children[i - 1];
+        children[i]->position_ = i;
+      }
+      children[0] = moved_child;
+      moved_child->parent_ = right;
+      moved_child->position_ = 0;
+    }
+    --left->count_;
+    ++right->count_;
+  };
+
+  // Moves the first element of child index + 1 up into the parent and the
+  // separator down onto the end of child index.
+  void RotateLeft(Node *parent, int index) {
+    Node *left = Child(parent, index);
+    Node *right = Child(parent, index + 1);
+    new (left->values_ + left->count_)
+        key_type(std::move(parent->values_[index]));
+    ++left->count_;
+    parent->values_[index] = std::move(right->values_[0]);
+    if (!right->leaf_) {
+      Node **children = static_cast<InnerNode *>(right)->children_;
+      Node *moved_child = children[0];
+      static_cast<InnerNode *>(left)->children_[left->count_] = moved_child;
+      moved_child->parent_ = left;
+      moved_child->position_ = left->count_;
+      for (int i = 0; i < right->count_; ++i) {
+        children[i] = children[i + 1];
+        children[i]->position_ = i;
+      }
+    }
+    CloseSlot(right, 0);
+  };
+
+  // Joins child index, the separator and child index + 1 into child index.
+  void Merge(Node *parent, int index) {
+    Node *left = Child(parent, index);
+    Node *right = Child(parent, index + 1);
+    new (left->values_ + left->count_)
+        key_type(std::move(parent->values_[index]));
+    MoveSlots(right, 0, right->count_, left, left->count_ + 1);
+    if (!left->leaf_) {
+      for (int i = 0; i <= right->count_; ++i) {
+        Node *child = Child(right, i);
+        static_cast<InnerNode *>(left)->children_[left->count_ + 1 + i] =
+            child;
+        child->parent_ = left;
+        child->position_ = left->count_ + 1 + i;
+      }
+    }
+    left->count_ += right->count_ + 1;
+    right->count_ = 0;
+    Node **children = static_cast<InnerNode *>(parent)->children_;
+    for (int i = index + 1; i < parent->count_; ++i) {
+      children[i] = children[i + 1];
+      children[i]->position_ = i;
+    }
+    CloseSlot(parent, index);
+    DeleteNode(right);
+  };
+
+  // A throw frees whatever part of the copy was built.
+  Node *CloneSubtree(Node *source, Node *parent) {
+    Node *copy = source->leaf_ ? new Node : new InnerNode;
+    copy->parent_ = parent;
+    copy->position_ = source->position_;
+    int children = 0;
+    try {
+      for (; copy->count_ < source->count_; ++copy->count_)
+        new (copy->values_ + copy->count_)
+            key_type(source->values_[copy->count_]);
+      if (!source->leaf_)
+        for (; children <= source->count_; ++children)
+          static_cast<InnerNode *>(copy)->children_[children] =
+              CloneSubtree(Child(source, children), copy);
+    } catch (...) {
+      for (int i = 0; i < children; ++i) DestroySubtree(Child(copy, i));
+      DeleteNode(copy);
+      throw;
+    }
+    return copy;
+  };
+
+  void DestroySubtree(Node *node) {
+    if (node) {
+      if (!node->leaf_)
+        for (int i = 0; i <= node->count_; ++i)
+          DestroySubtree(Child(node, i));
+      DeleteNode(node);
+    }
+  };
+
+  static void DeleteNode(Node *node) {
+    if (node->leaf_) {
+      delete node;
+    } else {
+      delete static_cast<InnerNode *>(node);
+    }
+  };
+};
+
+#endif  // S21_CONTAINERS_HEADERS_S21_BTREE_H_
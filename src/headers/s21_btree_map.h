@@ -0,0 +1,107 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_BTREE_MAP_H_
+#define S21_CONTAINERS_HEADERS_S21_BTREE_MAP_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Map over a B-tree: the same interface as Map, with fewer cache misses per
+// lookup. Insertions and erasures invalidate all iterators.
+template <class Key, class T, class Compare = s21::PairComp<Key, T>>
+class BTreeMap : public BTree<std::pair<Key, T>, Compare> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree = BTree<value_type, key_compare>;
+  using iterator = typename tree::Iterator;
+  using const_iterator = typename tree::ConstIterator;
+  using size_type = size_t;
+
+  BTreeMap(){};
+
+  BTreeMap(std::initializer_list<value_type> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  T &operator[](const Key &key) {
+    auto answer =
+        this->InsertUnique(Probe(key), [&] { return value_type(key, T()); });
+    return (*answer.first).second;
+  };
+
+  template <class K>
+  T &at(const K &key) {
+    iterator it = this->Find(Probe(key));
+    if (it == this->end()) throw std::out_of_range("s21::map::at");
+    return (*it).second;
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value, [&] { return value; });
+  };
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return this->InsertUnique(Probe(key),
+                              [&] { return value_type(key, obj); });
+  };
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    std::pair<iterator, bool> answer = insert(key, obj);
+    if (!answer.second) (*answer.first).second = obj;
+    return answer;
+  };
+
+  // Moves the elements whose keys are missing here out of other.
+  void merge(BTreeMap &other) {
+    BTreeMap rest;
+    for (auto it = other.begin(); it != other.end(); ++it)
+      if (!insert(*it).second) rest.insert(*it);
+    other.swap(rest);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    return this->Find(Probe(key));
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != this->end();
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return this->LowerBound(Probe(key));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return this->UpperBound(Probe(key));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return this->EqualRange(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::PairProbe<Key, T, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_BTREE_MAP_H_
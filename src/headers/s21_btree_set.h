@@ -0,0 +1,80 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_BTREE_SET_H_
+#define S21_CONTAINERS_HEADERS_S21_BTREE_SET_H_
+
+#include <initializer_list>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// Set over a B-tree: the same interface as Set, with fewer cache misses per
+// lookup. Insertions and erasures invalidate all iterators.
+template <typename Key, class Compare = s21::SingleComp<Key>>
+class BTreeSet : public BTree<Key, Compare> {
+ public:
+  using key_type = Key;
+  using tree = BTree<Key, Compare>;
+  using value_type = typename tree::value_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using iterator = typename tree::Iterator;
+  using const_iterator = typename tree::ConstIterator;
+
+  BTreeSet(){};
+
+  BTreeSet(std::initializer_list<value_type> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value, [&] { return value; });
+  };
+
+  // Moves the elements missing here out of other.
+  void merge(BTreeSet &other) {
+    BTreeSet rest;
+    for (auto it = other.begin(); it != other.end(); ++it)
+      if (!insert(*it).second) rest.insert(*it);
+    other.swap(rest);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    return this->Find(Probe(key));
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != this->end();
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return this->LowerBound(Probe(key));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return this->UpperBound(Probe(key));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return this->EqualRange(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::KeyProbe<Key, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_BTREE_SET_H_
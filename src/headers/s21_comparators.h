@@ -1,43 +1,231 @@
 #ifndef S21_CONTAINERS_HEADERS_S21_COMPARATORS_H_
 #define S21_CONTAINERS_HEADERS_S21_COMPARATORS_H_
 
+#include <type_traits>
 #include <utility>
 
 namespace s21 {
+template <class L, class R, class = void>
+struct HasCompareMethod : std::false_type {};
+
+template <class L, class R>
+struct HasCompareMethod<L, R,
+                        std::void_t<decltype(std::declval<const L &>().compare(
+                            std::declval<const R &>()))>> : std::true_type {};
+
+// Comparators may offer Compare(a, b), a three-way comparison returning a
+// negative, zero or positive int. Trees use it to make one comparison per
+// level; comparators with only the six predicates keep working.
+template <class Comparator, class L, class R, class = void>
+struct HasThreeWayCompare : std::false_type {};
+
+template <class Comparator, class L, class R>
+struct HasThreeWayCompare<
+    Comparator, L, R,
+    std::void_t<decltype(std::declval<const Comparator &>().Compare(
+        std::declval<const L &>(), std::declval<const R &>()))>>
+    : std::true_type {};
+
+// Uses a compare() member, as std::string has, when one operand provides it.
+template <class L, class R>
+int ThreeWay(const L &a, const R &b) {
+  if constexpr (HasCompareMethod<L, R>::value) {
+    return a.compare(b);
+  } else if constexpr (HasCompareMethod<R, L>::value) {
+    int order = b.compare(a);
+    return (order < 0) - (order > 0);
+  } else {
+    return a < b ? -1 : b < a;
+  }
+}
+
+// One three-way comparison: negative, zero or positive as a is less than,
+// equal to or greater than b. Comparators without Compare fall back to
+// LessThan and GreaterThan.
+template <class Comparator, class L, class R>
+int Order(const Comparator &comparator, const L &a, const R &b) {
+  if constexpr (HasThreeWayCompare<Comparator, L, R>::value) {
+    return comparator.Compare(a, b);
+  } else {
+    return comparator.LessThan(a, b) ? -1 : comparator.GreaterThan(a, b);
+  }
+}
+
+template <class Comparator, class L, class R, class = void>
+struct HasLessThan : std::false_type {};
+
+template <class Comparator, class L, class R>
+struct HasLessThan<
+    Comparator, L, R,
+    std::void_t<decltype(std::declval<const Comparator &>().LessThan(
+        std::declval<const L &>(), std::declval<const R &>()))>>
+    : std::true_type {};
+
+// Whether Order accepts an L and an R.
+template <class Comparator, class L, class R>
+struct CanOrder
+    : std::bool_constant<HasThreeWayCompare<Comparator, L, R>::value ||
+                         HasLessThan<Comparator, L, R>::value> {};
+
+// A map key meeting the pairs of a map through their first member.
+template <class K>
+struct FirstOf {
+  const K &key;
+};
+
+template <class Comparator, class K, class R>
+int Order(const Comparator &comparator, const FirstOf<K> &a, const R &b) {
+  return Order(comparator, a.key, b.first);
+}
+
+template <class Comparator, class L, class K>
+int Order(const Comparator &comparator, const L &a, const FirstOf<K> &b) {
+  return Order(comparator, a.first, b.key);
+}
+
+template <class Compare, class = void>
+struct IsTransparent : std::false_type {};
+
+template <class Compare>
+struct IsTransparent<Compare, std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+// Two different arithmetic types, which transparent lookups convert rather
+// than compare directly.
+template <class A, class B>
+struct IsArithmeticMix
+    : std::bool_constant<std::is_arithmetic<A>::value &&
+                         std::is_arithmetic<B>::value &&
+                         !std::is_same<A, B>::value> {};
+
+// What set lookups hand to the comparator. Non-transparent comparators only
+// know how to compare two Keys. Other arithmetic types are converted too, so
+// that mixed-sign comparisons never happen.
+template <class Key, class Compare, class K>
+decltype(auto) KeyProbe(const K &key) {
+  if constexpr (std::is_same<K, Key>::value ||
+                (IsTransparent<Compare>::value &&
+                 !IsArithmeticMix<K, Key>::value)) {
+    return (key);
+  } else {
+    return Key(key);
+  }
+}
+
+// What map lookups hand to the comparator. Transparent comparators take the
+// key itself, converted to Key if it is a different arithmetic type. Others
+// get a whole pair with a default mapped value to compare.
+template <class Key, class T, class Compare, class K>
+decltype(auto) PairProbe(const K &key) {
+  if constexpr (!IsTransparent<Compare>::value) {
+    return std::pair<Key, T>(key, T());
+  } else if constexpr (IsArithmeticMix<K, Key>::value) {
+    return Key(key);
+  } else {
+    return (key);
+  }
+}
+
+// What map insertions search for key with. Non-transparent comparators
+// that order two Keys compare key with the key of each pair, so that
+// nothing is built while the key may already be present; others get
+// PairProbe.
+template <class Key, class T, class Compare>
+decltype(auto) InsertProbe(const Key &key) {
+  if constexpr (!IsTransparent<Compare>::value &&
+                CanOrder<Compare, Key, Key>::value) {
+    return FirstOf<Key>{key};
+  } else {
+    return PairProbe<Key, T, Compare>(key);
+  }
+}
+
+// Both comparators are transparent: their predicates accept any pair of
+// operands comparable with each other, so lookups need no temporary key.
 template <class A>
 struct SingleComp {
   using type = A;
-  bool LessThan(const type &a, const type &b) const { return a < b; };
-  bool GreaterThan(const type &a, const type &b) const { return a > b; };
-  bool LessOrEquals(const type &a, const type &b) const { return a <= b; };
-  bool GreaterOrEquals(const type &a, const type &b) const { return a >= b; };
-  bool Equals(const type &a, const type &b) const { return a == b; };
-  bool NotEquals(const type &a, const type &b) const { return a != b; };
+  using is_transparent = void;
+
+  template <class L, class R>
+  int Compare(const L &a, const R &b) const {
+    return ThreeWay(a, b);
+  };
+
+  template <class L, class R>
+  bool LessThan(const L &a, const R &b) const {
+    return a < b;
+  };
+  template <class L, class R>
+  bool GreaterThan(const L &a, const R &b) const {
+    return a > b;
+  };
+  template <class L, class R>
+  bool LessOrEquals(const L &a, const R &b) const {
+    return a <= b;
+  };
+  template <class L, class R>
+  bool GreaterOrEquals(const L &a, const R &b) const {
+    return a >= b;
+  };
+  template <class L, class R>
+  bool Equals(const L &a, const R &b) const {
+    return a == b;
+  };
+  template <class L, class R>
+  bool NotEquals(const L &a, const R &b) const {
+    return a != b;
+  };
 };
 
+// Compares pairs by their first members. A bare key may stand in for either
+// pair.
 template <class A, class B>
 struct PairComp {
   using pair = std::pair<A, B>;
-  bool LessThan(const pair &a, const pair &b) const {
-    return a.first < b.first;
+  using is_transparent = void;
+
+  template <class L, class R>
+  int Compare(const L &a, const R &b) const {
+    return ThreeWay(KeyOf(a), KeyOf(b));
   };
-  bool GreaterThan(const pair &a, const pair &b) const {
-    return a.first > b.first;
+
+  template <class L, class R>
+  bool LessThan(const L &a, const R &b) const {
+    return KeyOf(a) < KeyOf(b);
+  };
+  template <class L, class R>
+  bool GreaterThan(const L &a, const R &b) const {
+    return KeyOf(a) > KeyOf(b);
   };
-  bool LessOrEquals(const pair &a, const pair &b) const {
-    return a.first <= b.first;
+  template <class L, class R>
+  bool LessOrEquals(const L &a, const R &b) const {
+    return KeyOf(a) <= KeyOf(b);
   };
-  bool GreaterOrEquals(const pair &a, const pair &b) const {
-    return a.first >= b.first;
+  template <class L, class R>
+  bool GreaterOrEquals(const L &a, const R &b) const {
+    return KeyOf(a) >= KeyOf(b);
   };
-  bool Equals(const pair &a, const pair &b) const {
-    return a.first == b.first;
+  template <class L, class R>
+  bool Equals(const L &a, const R &b) const {
+    return KeyOf(a) == KeyOf(b);
   };
-  bool NotEquals(const pair &a, const pair &b) const {
-    return a.first != b.first;
+  template <class L, class R>
+  bool NotEquals(const L &a, const R &b) const {
+    return KeyOf(a) != KeyOf(b);
+  };
+
+  static const A &KeyOf(const pair &a) { return a.first; };
+  template <class K>
+  static const K &KeyOf(const K &key) {
+    return key;
   };
 };
 
+// Tag for constructors whose input is already sorted by the comparator and
+// free of duplicates; such input is laid out without any comparisons.
+struct assume_sorted_t {};
+inline constexpr assume_sorted_t assume_sorted{};
 }  // namespace s21
 
 #endif  // S21_CONTAINERS_HEADERS_S21_COMPARATORS_H_
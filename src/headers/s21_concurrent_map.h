@@ -0,0 +1,152 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_CONCURRENT_MAP_H_
+#define S21_CONTAINERS_HEADERS_S21_CONCURRENT_MAP_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+#include "s21_map.h"
+
+namespace s21 {
+// Map safe to share between threads. Keys are spread by hash over shards,
+// each a Map behind its own reader-writer lock, so threads working on
+// different shards never wait for each other and readers of one shard run
+// together. No iterators are handed out: lookups return copies, and whole
+// map walks go through for_each or snapshots.
+template <class Key, class T, class Hash = std::hash<Key>,
+          class Compare = s21::PairComp<Key, T>>
+class ConcurrentMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using map_type = s21::Map<Key, T, Compare>;
+  using size_type = size_t;
+
+  static constexpr size_type kDefaultShards = 64;
+
+  // The shard count is rounded up to a power of two.
+  explicit ConcurrentMap(size_type shards = kDefaultShards) {
+    while (shard_count_ < shards) {
+      shard_count_ *= 2;
+      ++shard_bits_;
+    }
+    shards_.reset(new Shard[shard_count_]);
+  };
+
+  ConcurrentMap(const ConcurrentMap &other) = delete;
+  ConcurrentMap &operator=(const ConcurrentMap &other) = delete;
+
+  // Copy of the value mapped to key, if there is one.
+  std::optional<T> find(const Key &key) {
+    Shard &shard = ShardOf(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return std::nullopt;
+    return (*it).second;
+  };
+
+  bool contains(const Key &key) {
+    Shard &shard = ShardOf(key);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.contains(key);
+  };
+
+  // Returns whether key was missing and got inserted.
+  bool insert(const Key &key, const T &obj) {
+    Shard &shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.insert(key, obj).second;
+  };
+
+  bool insert_or_assign(const Key &key, const T &obj) {
+    Shard &shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.insert_or_assign(key, obj).second;
+  };
+
+  // Returns the number of elements erased, 0 or 1.
+  size_type erase(const Key &key) {
+    Shard &shard = ShardOf(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return 0;
+    shard.map.erase(it);
+    return 1;
+  };
+
+  // Sums the shard sizes one shard at a time, so concurrent writes may make
+  // it neither the size before nor the size after them.
+  size_type size() {
+    size_type total = 0;
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+      total += shards_[i].map.size();
+    }
+    return total;
+  };
+
+  bool empty() { return !size(); };
+
+  void clear() {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+      shards_[i].map.clear();
+    }
+  };
+
+  // Calls function(const value_type &) for every element, shard by shard,
+  // holding each shard's read lock while it is visited. function must not
+  // call back into this map for the same shard to write.
+  template <class Function>
+  void for_each(Function &&function) {
+    for (size_type i = 0; i < shard_count_; ++i) {
+      std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+      for (auto it = shards_[i].map.begin(); it != shards_[i].map.end(); ++it)
+        function(static_cast<const value_type &>(*it));
+    }
+  };
+
+  size_type shard_count() const { return shard_count_; };
+
+  // Copy of one shard, consistent as of one moment in that shard.
+  map_type snapshot(size_type shard) {
+    std::shared_lock<std::shared_mutex> lock(shards_[shard].mutex);
+    return map_type(shards_[shard].map);
+  };
+
+  // Copies of every shard, each consistent on its own.
+  std::vector<map_type> snapshot() {
+    std::vector<map_type> shards;
+    shards.reserve(shard_count_);
+    for (size_type i = 0; i < shard_count_; ++i)
+      shards.push_back(snapshot(i));
+    return shards;
+  };
+
+ private:
+  // Aligned so that neighbouring shard locks do not share a cache line.
+  struct alignas(64) Shard {
+    std::shared_mutex mutex;
+    map_type map;
+  };
+
+  std::unique_ptr<Shard[]> shards_;
+  size_type shard_count_ = 1;
+  int shard_bits_ = 0;
+  Hash hash_;
+
+  // Fibonacci hashing: the top bits of the product mix all bits of the
+  // hash, which std::hash leaves as the identity for integers.
+  Shard &ShardOf(const Key &key) {
+    unsigned long long mixed =
+        static_cast<unsigned long long>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return shards_[shard_bits_ ? mixed >> (64 - shard_bits_) : 0];
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_CONCURRENT_MAP_H_
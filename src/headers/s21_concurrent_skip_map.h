@@ -0,0 +1,101 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_CONCURRENT_SKIP_MAP_H_
+#define S21_CONTAINERS_HEADERS_S21_CONCURRENT_SKIP_MAP_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_skip_list.h"
+
+namespace s21 {
+// Ordered map many threads may read and write at once without locks. It has
+// the lookup interface of Map, but mapped values are fixed once inserted:
+// readers hold references into elements without locks, so a value changes
+// only by erasing and inserting its key again. Iterators are forward only,
+// weakly consistent, and must stay on the thread that made them.
+template <class Key, class T, class Compare = s21::PairComp<Key, T>>
+class ConcurrentSkipMap
+    : public ConcurrentSkipList<std::pair<Key, T>, Compare> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using const_reference = const value_type &;
+  using list = ConcurrentSkipList<value_type, key_compare>;
+  using iterator = typename list::Iterator;
+  using const_iterator = typename list::Iterator;
+  using size_type = size_t;
+
+  ConcurrentSkipMap(){};
+
+  ConcurrentSkipMap(std::initializer_list<value_type> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  // A copy, as the element may be erased and freed once this returns.
+  template <class K>
+  T at(const K &key) {
+    auto guard = this->Pin();
+    auto *node = this->Find(Probe(key));
+    if (!node) throw std::out_of_range("s21::concurrent_skip_map::at");
+    return node->data_.second;
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value, [&] { return value; });
+  };
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return this->InsertUnique(Probe(key),
+                              [&] { return value_type(key, obj); });
+  };
+
+  using list::erase;
+
+  // Returns the number of elements erased, 0 or 1.
+  template <class K>
+  size_type erase(const K &key) {
+    auto guard = this->Pin();
+    auto *node = this->Find(Probe(key));
+    return node && this->Remove(node);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    auto guard = this->Pin();
+    return iterator(this->Find(Probe(key)), guard);
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    auto guard = this->Pin();
+    return this->Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    auto guard = this->Pin();
+    return iterator(this->LowerBound(Probe(key)), guard);
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    auto guard = this->Pin();
+    return iterator(this->UpperBound(Probe(key)), guard);
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::PairProbe<Key, T, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_CONCURRENT_SKIP_MAP_H_
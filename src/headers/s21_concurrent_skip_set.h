@@ -0,0 +1,81 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_CONCURRENT_SKIP_SET_H_
+#define S21_CONTAINERS_HEADERS_S21_CONCURRENT_SKIP_SET_H_
+
+#include <initializer_list>
+
+#include "s21_skip_list.h"
+
+namespace s21 {
+// Ordered set many threads may read and write at once without locks. It has
+// the lookup interface of Set; iterators are forward only, weakly
+// consistent, and must stay on the thread that made them.
+template <typename Key, class Compare = s21::SingleComp<Key>>
+class ConcurrentSkipSet : public ConcurrentSkipList<Key, Compare> {
+ public:
+  using key_type = Key;
+  using list = ConcurrentSkipList<Key, Compare>;
+  using value_type = typename list::value_type;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using iterator = typename list::Iterator;
+  using const_iterator = typename list::Iterator;
+
+  ConcurrentSkipSet(){};
+
+  ConcurrentSkipSet(std::initializer_list<value_type> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value, [&] { return value; });
+  };
+
+  using list::erase;
+
+  // Returns the number of elements erased, 0 or 1.
+  template <class K>
+  size_type erase(const K &key) {
+    auto guard = this->Pin();
+    auto *node = this->Find(Probe(key));
+    return node && this->Remove(node);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    auto guard = this->Pin();
+    return iterator(this->Find(Probe(key)), guard);
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    auto guard = this->Pin();
+    return this->Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    auto guard = this->Pin();
+    return iterator(this->LowerBound(Probe(key)), guard);
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    auto guard = this->Pin();
+    return iterator(this->UpperBound(Probe(key)), guard);
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::KeyProbe<Key, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_CONCURRENT_SKIP_SET_H_
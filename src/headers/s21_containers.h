@@ -3,11 +3,19 @@
 
 #include <iostream>
 
+#include "s21_btree_map.h"
+#include "s21_btree_set.h"
+#include "s21_flat_map.h"
+#include "s21_flat_set.h"
+#include "s21_frozen_map.h"
+#include "s21_frozen_set.h"
 #include "s21_list.h"
 #include "s21_map.h"
 #include "s21_queue.h"
 #include "s21_set.h"
 #include "s21_stack.h"
+#include "s21_unordered_map.h"
+#include "s21_unordered_set.h"
 #include "s21_vector.h"
 
 #endif  // S21_CONTAINERS_HEADERS_S21_CONTAINERS_H_
@@ -0,0 +1,11 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_CONTAINERSPLUS_H_
+#define S21_CONTAINERS_HEADERS_S21_CONTAINERSPLUS_H_
+
+#include "s21_concurrent_map.h"
+#include "s21_concurrent_skip_map.h"
+#include "s21_concurrent_skip_set.h"
+#include "s21_multimap.h"
+#include "s21_multiset.h"
+#include "s21_persistent_map.h"
+
+#endif  // S21_CONTAINERS_HEADERS_S21_CONTAINERSPLUS_H_
@@ -0,0 +1,159 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_EPOCH_H_
+#define S21_CONTAINERS_HEADERS_S21_EPOCH_H_
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Epoch-based reclamation for lock-free containers. A thread pins the
+// current epoch for as long as it may hold pointers into shared nodes; an
+// unlinked node is retired instead of deleted, and freed once the global
+// epoch has moved on twice, which happens only after every pinned thread
+// has seen the epoch it was retired in. One domain serves the process.
+class EpochDomain {
+  struct Record;
+
+ public:
+  // Pins the calling thread while alive. Guards nest, and each belongs to
+  // the thread that made it.
+  class Guard {
+   public:
+    Guard() : record_(nullptr){};
+    explicit Guard(EpochDomain &domain) : record_(domain.Local()) {
+      Enter();
+    };
+    Guard(const Guard &other) : record_(other.record_) { Enter(); };
+    Guard(Guard &&other) : record_(other.record_) { other.record_ = nullptr; };
+    ~Guard() { Leave(); };
+
+    Guard &operator=(Guard other) {
+      std::swap(record_, other.record_);
+      return *this;
+    };
+
+   private:
+    Record *record_;
+
+    void Enter();
+    void Leave();
+  };
+
+  static EpochDomain &Instance() {
+    static EpochDomain domain;
+    return domain;
+  };
+
+  Guard Pin() { return Guard(*this); };
+
+  // Frees object with deleter once no thread pinned now can still reach
+  // it. The caller must have unlinked it already.
+  void Retire(void *object, void (*deleter)(void *)) {
+    Record *record = Local();
+    record->retired_.push_back(
+        Retired{object, deleter, epoch_.load()});
+    if (++record->retires_ % kCollectEvery == 0) Collect(record);
+  };
+
+  ~EpochDomain() {
+    for (Record *record = records_.load(); record;) {
+      Record *next = record->next_;
+      for (Retired &retired : record->retired_)
+        retired.deleter(retired.object);
+      delete record;
+      record = next;
+    }
+  };
+
+ private:
+  friend class Guard;
+
+  static constexpr size_t kCollectEvery = 64;
+
+  struct Retired {
+    void *object;
+    void (*deleter)(void *);
+    uint64_t epoch;
+  };
+
+  // Per-thread state. local_ is the pinned epoch times two plus one, or
+  // zero while unpinned. Records are reused by later threads, never freed
+  // before the domain.
+  struct Record {
+    std::atomic<uint64_t> local_{0};
+    std::atomic<bool> in_use_{true};
+    Record *next_ = nullptr;
+    int depth_ = 0;
+    size_t retires_ = 0;
+    std::vector<Retired> retired_;
+  };
+
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<Record *> records_{nullptr};
+
+  EpochDomain(){};
+
+  // Gives the calling thread a record for its lifetime.
+  Record *Local() {
+    struct Owner {
+      Record *record = nullptr;
+      ~Owner() {
+        if (record) record->in_use_.store(false);
+      };
+    };
+    static thread_local Owner owner;
+    if (!owner.record) owner.record = Acquire();
+    return owner.record;
+  };
+
+  Record *Acquire() {
+    for (Record *record = records_.load(); record; record = record->next_) {
+      bool free = false;
+      if (!record->in_use_.load() &&
+          record->in_use_.compare_exchange_strong(free, true))
+        return record;
+    }
+    Record *record = new Record;
+    record->next_ = records_.load();
+    while (!records_.compare_exchange_weak(record->next_, record)) {
+    }
+    return record;
+  };
+
+  // Moves the epoch on if every pinned thread has seen it, then frees what
+  // was retired two epochs ago or earlier.
+  void Collect(Record *record) {
+    uint64_t epoch = epoch_.load();
+    bool behind = false;
+    for (Record *other = records_.load(); other && !behind;
+         other = other->next_) {
+      uint64_t local = other->local_.load();
+      behind = local && local / 2 != epoch;
+    }
+    if (!behind && epoch_.compare_exchange_strong(epoch, epoch + 1)) ++epoch;
+    size_t kept = 0;
+    for (Retired &retired : record->retired_) {
+      if (retired.epoch + 2 <= epoch) {
+        retired.deleter(retired.object);
+      } else {
+        record->retired_[kept++] = retired;
+      }
+    }
+    record->retired_.resize(kept);
+  };
+};
+
+inline void EpochDomain::Guard::Enter() {
+  if (record_ && !record_->depth_++) {
+    uint64_t epoch = Instance().epoch_.load();
+    record_->local_.store(epoch * 2 + 1);
+  }
+}
+
+inline void EpochDomain::Guard::Leave() {
+  if (record_ && !--record_->depth_) record_->local_.store(0);
+}
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_EPOCH_H_
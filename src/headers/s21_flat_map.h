@@ -0,0 +1,119 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_FLAT_MAP_H_
+#define S21_CONTAINERS_HEADERS_S21_FLAT_MAP_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+// Map kept as a sorted array of pairs: the interface of Map for read-mostly
+// tables, with a fraction of its memory and no pointer chasing on lookups.
+template <class Key, class T, class Compare = s21::PairComp<Key, T>>
+class FlatMap : public FlatTree<std::pair<Key, T>, Compare> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree = FlatTree<value_type, key_compare>;
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::const_iterator;
+  using size_type = size_t;
+
+  FlatMap(){};
+
+  FlatMap(std::initializer_list<value_type> const &items) {
+    this->InsertMany(items.begin(), items.end());
+  };
+
+  T &operator[](const Key &key) {
+    auto answer =
+        this->InsertUnique(Probe(key), [&] { return value_type(key, T()); });
+    return (*answer.first).second;
+  };
+
+  template <class K>
+  T &at(const K &key) {
+    iterator it = this->Find(Probe(key));
+    if (it == this->end()) throw std::out_of_range("s21::map::at");
+    return (*it).second;
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value, [&] { return value; });
+  };
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return this->InsertUnique(Probe(key),
+                              [&] { return value_type(key, obj); });
+  };
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    std::pair<iterator, bool> answer = insert(key, obj);
+    if (!answer.second) (*answer.first).second = obj;
+    return answer;
+  };
+
+  // Inserts a batch with one sort and one merge instead of an array shift
+  // per element. Keys already present keep their mapped values.
+  template <class InputIt>
+  void insert_many(InputIt first, InputIt last) {
+    this->InsertMany(first, last);
+  };
+
+  void insert_many(std::initializer_list<value_type> const &items) {
+    this->InsertMany(items.begin(), items.end());
+  };
+
+  // Moves the elements whose keys are missing here out of other.
+  void merge(FlatMap &other) {
+    FlatMap rest;
+    for (auto it = other.begin(); it != other.end(); ++it)
+      if (contains((*it).first)) rest.data_.push_back(*it);
+    this->InsertMany(other.begin(), other.end());
+    other.swap(rest);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    return this->Find(Probe(key));
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != this->end();
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return this->LowerBound(Probe(key));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return this->UpperBound(Probe(key));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return this->EqualRange(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::PairProbe<Key, T, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_FLAT_MAP_H_
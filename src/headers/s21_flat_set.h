@@ -0,0 +1,92 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_FLAT_SET_H_
+#define S21_CONTAINERS_HEADERS_S21_FLAT_SET_H_
+
+#include <initializer_list>
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+// Set kept as a sorted array: the interface of Set for read-mostly tables,
+// with a fraction of its memory and no pointer chasing on lookups.
+template <typename Key, class Compare = s21::SingleComp<Key>>
+class FlatSet : public FlatTree<Key, Compare> {
+ public:
+  using key_type = Key;
+  using tree = FlatTree<Key, Compare>;
+  using value_type = typename tree::value_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::const_iterator;
+
+  FlatSet(){};
+
+  FlatSet(std::initializer_list<value_type> const &items) {
+    this->InsertMany(items.begin(), items.end());
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value, [&] { return value; });
+  };
+
+  // Inserts a batch with one sort and one merge instead of an array shift
+  // per element.
+  template <class InputIt>
+  void insert_many(InputIt first, InputIt last) {
+    this->InsertMany(first, last);
+  };
+
+  void insert_many(std::initializer_list<value_type> const &items) {
+    this->InsertMany(items.begin(), items.end());
+  };
+
+  // Moves the elements missing here out of other.
+  void merge(FlatSet &other) {
+    FlatSet rest;
+    for (auto it = other.begin(); it != other.end(); ++it)
+      if (contains(*it)) rest.data_.push_back(*it);
+    this->InsertMany(other.begin(), other.end());
+    other.swap(rest);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    return this->Find(Probe(key));
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != this->end();
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return this->LowerBound(Probe(key));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return this->UpperBound(Probe(key));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return this->EqualRange(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::KeyProbe<Key, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_FLAT_SET_H_
@@ -0,0 +1,128 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_FLAT_TREE_H_
+#define S21_CONTAINERS_HEADERS_S21_FLAT_TREE_H_
+
+#include <algorithm>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_vector.h"
+
+// Ordered unique elements kept sorted in one contiguous s21::Vector. Lookups
+// are binary searches over the array; single insertions and erasures shift
+// the elements after them, so batches should go through InsertMany. Any
+// insertion or erasure invalidates all iterators.
+template <class Key, class Compare = s21::SingleComp<Key>>
+class FlatTree {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = key_type &;
+  using const_reference = const key_type &;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+  using size_type = size_t;
+
+  iterator begin() { return data_.data(); };
+
+  iterator end() { return data_.data() + data_.size(); };
+
+  const_iterator cbegin() const {
+    return const_cast<FlatTree *>(this)->begin();
+  };
+
+  const_iterator cend() const { return const_cast<FlatTree *>(this)->end(); };
+
+  bool empty() const { return data_.empty(); };
+
+  size_type size() const { return data_.size(); };
+
+  size_type max_size() const { return data_.max_size(); };
+
+  void clear() { data_.clear(); };
+
+  // Returns the iterator following the erased element.
+  iterator erase(iterator pos) { return erase(pos, pos + 1); };
+
+  iterator erase(iterator first, iterator last) {
+    size_type index = first - begin();
+    size_type count = last - first;
+    std::move(last, end(), first);
+    for (; count; --count) data_.pop_back();
+    return begin() + index;
+  };
+
+  void swap(FlatTree &other) { data_.swap(other.data_); };
+
+ protected:
+  s21::Vector<value_type> data_;
+  key_compare comparator;
+
+  template <class L, class R>
+  int Order(const L &a, const R &b) const {
+    return s21::Order(comparator, a, b);
+  };
+
+  template <class K>
+  iterator Find(const K &key) {
+    iterator it = LowerBound(key);
+    return it != end() && !Order(key, *it) ? it : end();
+  };
+
+  template <class K>
+  iterator LowerBound(const K &key) {
+    return std::lower_bound(begin(), end(), key,
+                            [this](const value_type &element, const K &probe) {
+                              return Order(element, probe) < 0;
+                            });
+  };
+
+  template <class K>
+  iterator UpperBound(const K &key) {
+    return std::upper_bound(begin(), end(), key,
+                            [this](const K &probe, const value_type &element) {
+                              return Order(probe, element) < 0;
+                            });
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> EqualRange(const K &key) {
+    iterator first = LowerBound(key);
+    iterator last = first;
+    if (first != end() && !Order(key, *first)) ++last;
+    return std::pair<iterator, iterator>(first, last);
+  };
+
+  // Inserts the value made by make unless an element equal to key exists.
+  template <class K, class Make>
+  std::pair<iterator, bool> InsertUnique(const K &key, Make &&make) {
+    iterator it = LowerBound(key);
+    if (it != end() && !Order(key, *it))
+      return std::pair<iterator, bool>(it, false);
+    size_type index = it - begin();
+    data_.insert(typename s21::Vector<value_type>::iterator(it), make());
+    return std::pair<iterator, bool>(begin() + index, true);
+  };
+
+  // Appends the batch, sorts it and merges it into the stored elements in
+  // O(n + k log k). Elements already stored, and the first of equal batch
+  // elements, win over later equal ones.
+  template <class InputIt>
+  void InsertMany(InputIt first, InputIt last) {
+    size_type stored = size();
+    for (; first != last; ++first) data_.push_back(*first);
+    auto less = [this](const value_type &a, const value_type &b) {
+      return Order(a, b) < 0;
+    };
+    std::stable_sort(begin() + stored, end(), less);
+    std::inplace_merge(begin(), begin() + stored, end(), less);
+    iterator kept = std::unique(
+        begin(), end(),
+        [this](const value_type &a, const value_type &b) {
+          return !Order(a, b);
+        });
+    erase(kept, end());
+  };
+};
+
+#endif  // S21_CONTAINERS_HEADERS_S21_FLAT_TREE_H_
@@ -0,0 +1,90 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_FROZEN_MAP_H_
+#define S21_CONTAINERS_HEADERS_S21_FROZEN_MAP_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_frozen_tree.h"
+
+namespace s21 {
+// Immutable map for tables built once and then only queried, as made by
+// Map::freeze(). Point queries are several times faster than in Map;
+// neither the keys nor the mapped values can change.
+template <class Key, class T, class Compare = s21::PairComp<Key, T>>
+class FrozenMap : public FrozenTree<std::pair<Key, T>, Compare> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using tree = FrozenTree<value_type, key_compare>;
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::const_iterator;
+  using size_type = size_t;
+
+  FrozenMap(){};
+
+  // Of equal keys, the first one given wins.
+  FrozenMap(std::initializer_list<value_type> const &items) {
+    this->Assign(items.begin(), items.end());
+  };
+
+  template <class InputIt>
+  FrozenMap(InputIt first, InputIt last) {
+    this->Assign(first, last);
+  };
+
+  template <class ForwardIt>
+  FrozenMap(s21::assume_sorted_t, ForwardIt first, ForwardIt last) {
+    this->AssignSorted(first, last);
+  };
+
+  template <class K>
+  const T &at(const K &key) const {
+    size_type index = this->Find(Probe(key));
+    if (!index) throw std::out_of_range("s21::map::at");
+    return this->At(index).second;
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) const {
+    return iterator(this, this->Find(Probe(key)));
+  };
+
+  template <class K>
+  bool contains(const K &key) const {
+    return this->Find(Probe(key)) != 0;
+  };
+
+  template <class K>
+  size_type count(const K &key) const {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) const {
+    return iterator(this, this->LowerBound(Probe(key)));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) const {
+    return iterator(this, this->UpperBound(Probe(key)));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return this->EqualRange(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::PairProbe<Key, T, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_FROZEN_MAP_H_
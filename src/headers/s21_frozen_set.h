@@ -0,0 +1,79 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_FROZEN_SET_H_
+#define S21_CONTAINERS_HEADERS_S21_FROZEN_SET_H_
+
+#include <initializer_list>
+
+#include "s21_frozen_tree.h"
+
+namespace s21 {
+// Immutable set for tables built once and then only queried, as made by
+// Set::freeze(). Point queries are several times faster than in Set; the
+// elements cannot be inserted, erased or modified.
+template <typename Key, class Compare = s21::SingleComp<Key>>
+class FrozenSet : public FrozenTree<Key, Compare> {
+ public:
+  using key_type = Key;
+  using tree = FrozenTree<Key, Compare>;
+  using value_type = typename tree::value_type;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::const_iterator;
+
+  FrozenSet(){};
+
+  FrozenSet(std::initializer_list<value_type> const &items) {
+    this->Assign(items.begin(), items.end());
+  };
+
+  template <class InputIt>
+  FrozenSet(InputIt first, InputIt last) {
+    this->Assign(first, last);
+  };
+
+  template <class ForwardIt>
+  FrozenSet(s21::assume_sorted_t, ForwardIt first, ForwardIt last) {
+    this->AssignSorted(first, last);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) const {
+    return iterator(this, this->Find(Probe(key)));
+  };
+
+  template <class K>
+  bool contains(const K &key) const {
+    return this->Find(Probe(key)) != 0;
+  };
+
+  template <class K>
+  size_type count(const K &key) const {
+    return contains(key);
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) const {
+    return iterator(this, this->LowerBound(Probe(key)));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) const {
+    return iterator(this, this->UpperBound(Probe(key)));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) const {
+    return this->EqualRange(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::KeyProbe<Key, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_FROZEN_SET_H_
@@ -0,0 +1,232 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_FROZEN_TREE_H_
+#define S21_CONTAINERS_HEADERS_S21_FROZEN_TREE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_vector.h"
+
+// Ordered unique elements that never change after construction, laid out in
+// Eytzinger order: the implicit binary search tree of the sorted elements
+// stored level by level, the children of the element at index k sitting at
+// 2k and 2k + 1 (counted from 1). A search touches the array top-down with
+// no branches on the comparisons, and fetches the grandchildren of each
+// element it visits before it needs them, so the misses of the next levels
+// overlap with the comparisons of this one.
+template <class Key, class Compare = s21::SingleComp<Key>>
+class FrozenTree {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = const key_type &;
+  using const_reference = const key_type &;
+  using size_type = size_t;
+
+  // Walks the implicit tree in order. Index 0 is the end.
+  class Iterator {
+   public:
+    Iterator() : tree_(nullptr), index_(0){};
+    Iterator(const FrozenTree *tree, size_type index)
+        : tree_(tree), index_(index){};
+
+    const_reference operator*() const { return tree_->At(index_); };
+
+    Iterator &operator++() {
+      index_ = tree_->Next(index_);
+      return *this;
+    };
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    // Stepping back from the end gives the last element.
+    Iterator &operator--() {
+      index_ = index_ ? tree_->Prev(index_) : tree_->Last();
+      return *this;
+    };
+
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    };
+
+    bool operator==(const Iterator &other) const {
+      return index_ == other.index_;
+    };
+
+    bool operator!=(const Iterator &other) const {
+      return index_ != other.index_;
+    };
+
+   private:
+    const FrozenTree *tree_;
+    size_type index_;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  iterator begin() const { return iterator(this, First()); };
+
+  iterator end() const { return iterator(this, 0); };
+
+  const_iterator cbegin() const { return begin(); };
+
+  const_iterator cend() const { return end(); };
+
+  bool empty() const { return data_.empty(); };
+
+  size_type size() const { return data_.size(); };
+
+  size_type max_size() const { return data_.max_size(); };
+
+  void swap(FrozenTree &other) { data_.swap(other.data_); };
+
+ protected:
+  // data_[k - 1] holds the element at index k.
+  s21::Vector<value_type> data_;
+  key_compare comparator;
+
+  template <class L, class R>
+  int Order(const L &a, const R &b) const {
+    return s21::Order(comparator, a, b);
+  };
+
+  const_reference At(size_type index) const { return data_[index - 1]; };
+
+  // Lays out elements given in ascending order by walking the indices in
+  // order.
+  template <class ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last) {
+    size_type count = 0;
+    for (ForwardIt it = first; it != last; ++it) ++count;
+    s21::Vector<value_type> data;
+    data.reserve(count);
+    for (size_type i = 0; i < count; ++i) data.push_back(value_type());
+    data_.swap(data);
+    for (size_type index = First(); index; index = Next(index), ++first)
+      data_[index - 1] = *first;
+  };
+
+  // Sorts a copy of the input and keeps the first of equal elements.
+  template <class InputIt>
+  void Assign(InputIt first, InputIt last) {
+    s21::Vector<value_type> sorted;
+    for (; first != last; ++first) sorted.push_back(*first);
+    value_type *begin = sorted.data();
+    value_type *end = begin + sorted.size();
+    std::stable_sort(begin, end, [this](const value_type &a,
+                                        const value_type &b) {
+      return Order(a, b) < 0;
+    });
+    end = std::unique(begin, end, [this](const value_type &a,
+                                         const value_type &b) {
+      return !Order(a, b);
+    });
+    AssignSorted(begin, end);
+  };
+
+  // The index of the first element not less than key, or 0. The descent
+  // records its turns in the bits of the index; once it falls off the
+  // tree, dropping the right turns after the last left turn, and that turn
+  // itself, leads back to the element where the search went left last.
+  template <class K>
+  size_type LowerBound(const K &key) const {
+    size_type count = size();
+    if (!count) return 0;
+    const value_type *data = &data_[0];
+    size_type index = 1;
+    while (index <= count) {
+      Prefetch(data, 4 * index - 1);
+      index = 2 * index + comparator.LessThan(data[index - 1], key);
+    }
+    return AfterLastLeftTurn(index);
+  };
+
+  // The index of the first element greater than key, or 0.
+  template <class K>
+  size_type UpperBound(const K &key) const {
+    size_type count = size();
+    if (!count) return 0;
+    const value_type *data = &data_[0];
+    size_type index = 1;
+    while (index <= count) {
+      Prefetch(data, 4 * index - 1);
+      index = 2 * index + !comparator.LessThan(key, data[index - 1]);
+    }
+    return AfterLastLeftTurn(index);
+  };
+
+  template <class K>
+  size_type Find(const K &key) const {
+    size_type index = LowerBound(key);
+    return index && !Order(key, At(index)) ? index : 0;
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> EqualRange(const K &key) const {
+    size_type index = LowerBound(key);
+    iterator first(this, index);
+    iterator last = first;
+    if (index && !comparator.LessThan(key, At(index))) ++last;
+    return std::pair<iterator, iterator>(first, last);
+  };
+
+ private:
+  // Hints the cache line of data[index]. The address is computed as an
+  // integer, as the grandchildren of the last levels lie past the array.
+  static void Prefetch(const value_type *data, size_type index) {
+#ifdef __GNUC__
+    __builtin_prefetch(reinterpret_cast<const void *>(
+        reinterpret_cast<uintptr_t>(data) + index * sizeof(value_type)));
+#else
+    (void)data;
+    (void)index;
+#endif
+  };
+
+  static size_type AfterLastLeftTurn(size_type index) {
+    while (index & 1) index >>= 1;
+    return index >> 1;
+  };
+
+  size_type First() const {
+    size_type index = size() ? 1 : 0;
+    while (index && 2 * index <= size()) index *= 2;
+    return index;
+  };
+
+  size_type Last() const {
+    size_type index = size() ? 1 : 0;
+    while (index && 2 * index + 1 <= size()) index = 2 * index + 1;
+    return index;
+  };
+
+  size_type Next(size_type index) const {
+    if (2 * index + 1 <= size()) {
+      index = 2 * index + 1;
+      while (2 * index <= size()) index *= 2;
+      return index;
+    }
+    return AfterLastLeftTurn(index);
+  };
+
+  size_type Prev(size_type index) const {
+    if (2 * index <= size()) {
+      index *= 2;
+      while (2 * index + 1 <= size()) index = 2 * index + 1;
+      return index;
+    }
+    while (index && !(index & 1)) index >>= 1;
+    return index >> 1;
+  };
+};
+
+#endif  // S21_CONTAINERS_HEADERS_S21_FROZEN_TREE_H_
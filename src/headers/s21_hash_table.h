@@ -0,0 +1,482 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_HASH_TABLE_H_
+#define S21_CONTAINERS_HEADERS_S21_HASH_TABLE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Open-addressing hash table in the Swiss-table layout. Each slot has a
+// control byte: empty, deleted, or the low seven bits of its element's
+// hash. A lookup loads the control bytes of kGroupWidth slots at once,
+// compares them all with those seven bits (one SSE2 compare where
+// available) and looks only at the elements that match. Groups are probed
+// in triangular steps from the slot picked by the other hash bits.
+//
+// The capacity is a power of two minus one. The control array ends with a
+// sentinel that stops iteration, followed by a copy of the first
+// kGroupWidth - 1 control bytes, so a group may be loaded at any slot. Any
+// insertion may move every element and invalidates all iterators; erasure
+// invalidates only iterators to the erased element.
+template <class Key, class Value, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class HashTable {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+  static constexpr int kGroupWidth = 16;
+
+ protected:
+  // Control bytes of full slots are in [0, 127].
+  static constexpr int8_t kEmpty = -128;
+  static constexpr int8_t kDeleted = -2;
+  static constexpr int8_t kSentinel = -1;
+
+  // The control bytes of kGroupWidth slots. Matches are bit masks with bit
+  // i set for slot i of the group.
+  class Group {
+   public:
+#ifdef __SSE2__
+    explicit Group(const int8_t *ctrl)
+        : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))){};
+
+    uint32_t Match(int8_t h2) const {
+      return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+    };
+
+    // Empty or deleted slots: the bytes below the sentinel.
+    uint32_t MatchFree() const {
+      return _mm_movemask_epi8(
+          _mm_cmpgt_epi8(_mm_set1_epi8(kSentinel), ctrl_));
+    };
+
+   private:
+    __m128i ctrl_;
+#else
+    explicit Group(const int8_t *ctrl) {
+      std::memcpy(ctrl_, ctrl, kGroupWidth);
+    };
+
+    uint32_t Match(int8_t h2) const {
+      uint32_t mask = 0;
+      for (int i = 0; i < kGroupWidth; ++i)
+        mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+      return mask;
+    };
+
+    uint32_t MatchFree() const {
+      uint32_t mask = 0;
+      for (int i = 0; i < kGroupWidth; ++i)
+        mask |= static_cast<uint32_t>(ctrl_[i] < kSentinel) << i;
+      return mask;
+    };
+
+   private:
+    int8_t ctrl_[kGroupWidth];
+#endif
+
+   public:
+    uint32_t MatchEmpty() const { return Match(kEmpty); };
+  };
+
+  static int TrailingZeros(uint32_t mask) {
+#ifdef __GNUC__
+    return __builtin_ctz(mask);
+#else
+    int count = 0;
+    for (; !(mask & 1); mask >>= 1) ++count;
+    return count;
+#endif
+  };
+
+  // Counted from the top bit of a group mask.
+  static int LeadingZeros(uint32_t mask) {
+    int count = 0;
+    for (uint32_t bit = 1u << (kGroupWidth - 1); bit && !(mask & bit);
+         bit >>= 1)
+      ++count;
+    return count;
+  };
+
+  // The control bytes of a table without slots: lookups find an empty slot
+  // at once and iteration ends at once.
+  static int8_t *EmptyGroup() {
+    alignas(16) static int8_t group[kGroupWidth] = {
+        kSentinel, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty,
+        kEmpty,    kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty, kEmpty};
+    return group;
+  };
+
+ public:
+  class Iterator {
+   public:
+    Iterator() : ctrl_(nullptr), slot_(nullptr){};
+    Iterator(int8_t *ctrl, value_type *slot) : ctrl_(ctrl), slot_(slot) {
+      SkipFree();
+    };
+
+    value_type &operator*() const { return *slot_; };
+
+    Iterator &operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipFree();
+      return *this;
+    };
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    bool operator==(const Iterator &other) const {
+      return ctrl_ == other.ctrl_;
+    };
+
+    bool operator!=(const Iterator &other) const { return !(*this == other); };
+
+    int8_t *ctrl() const { return ctrl_; };
+    value_type *slot() const { return slot_; };
+
+   private:
+    int8_t *ctrl_;
+    value_type *slot_;
+
+    void SkipFree() {
+      while (*ctrl_ < kSentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+    };
+  };
+
+  class ConstIterator {
+   public:
+    ConstIterator(){};
+    ConstIterator(const Iterator &other) : it_(other){};
+
+    const_reference operator*() const { return *it_; };
+
+    ConstIterator &operator++() {
+      ++it_;
+      return *this;
+    };
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    bool operator==(const ConstIterator &other) const {
+      return it_ == other.it_;
+    };
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    };
+
+   private:
+    Iterator it_;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  HashTable(){};
+
+  // Copies into a table of its own first, so that a throwing copy leaves
+  // nothing behind.
+  HashTable(const HashTable &other) {
+    if (!other.capacity_) return;
+    HashTable table;
+    table.Allocate(other.capacity_);
+    for (size_type i = 0; i < other.capacity_; ++i) {
+      if (other.ctrl_[i] < 0) continue;
+      new (table.slots_ + i) value_type(other.slots_[i]);
+      table.ctrl_[i] = other.ctrl_[i];
+    }
+    std::memcpy(table.ctrl_, other.ctrl_, other.capacity_ + kGroupWidth);
+    table.size_ = other.size_;
+    table.growth_left_ = other.growth_left_;
+    swap(table);
+  };
+
+  HashTable(HashTable &&other) { swap(other); };
+
+  ~HashTable() {
+    DestroyAll();
+    Deallocate();
+  };
+
+  HashTable &operator=(const HashTable &other) {
+    if (this != &other) {
+      HashTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  };
+
+  HashTable &operator=(HashTable &&other) {
+    HashTable tmp(std::move(other));
+    swap(tmp);
+    return *this;
+  };
+
+  iterator begin() { return iterator(ctrl_, slots_); };
+
+  iterator end() { return iterator(ctrl_ + capacity_, slots_ + capacity_); };
+
+  const_iterator cbegin() const {
+    return const_cast<HashTable *>(this)->begin();
+  };
+
+  const_iterator cend() const { return const_cast<HashTable *>(this)->end(); };
+
+  bool empty() const { return !size_; };
+
+  size_type size() const { return size_; };
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1);
+  };
+
+  // Keeps the capacity.
+  void clear() {
+    DestroyAll();
+    if (!capacity_) return;
+    ResetCtrl();
+    size_ = 0;
+    growth_left_ = GrowthFor(capacity_);
+  };
+
+  // Returns the iterator following the erased element.
+  iterator erase(iterator pos) {
+    size_type index = pos.ctrl() - ctrl_;
+    slots_[index].~value_type();
+    --size_;
+    // A slot may become empty again if no group holding it was ever full,
+    // since then no probe can have gone past it; otherwise it must stay
+    // marked so that probes keep going.
+    uint32_t empty_before =
+        Group(ctrl_ + ((index - kGroupWidth) & capacity_)).MatchEmpty();
+    uint32_t empty_after = Group(ctrl_ + index).MatchEmpty();
+    if (empty_before && empty_after &&
+        LeadingZeros(empty_before) + TrailingZeros(empty_after) <
+            kGroupWidth) {
+      SetCtrl(index, kEmpty);
+      ++growth_left_;
+    } else {
+      SetCtrl(index, kDeleted);
+    }
+    ++pos;
+    return pos;
+  };
+
+  void swap(HashTable &other) {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  };
+
+  // Makes room for count elements without further rehashing.
+  void reserve(size_type count) {
+    if (count > size_ + growth_left_) Resize(CapacityFor(count));
+  };
+
+  // Rebuilds the table with room for at least count slots and all present
+  // elements, dropping deleted markers. rehash(0) of an empty table frees
+  // its memory.
+  void rehash(size_type count) {
+    if (!count && !size_) {
+      Deallocate();
+      return;
+    }
+    size_type capacity = CapacityFor(size_);
+    while (capacity < count) capacity = capacity * 2 + 1;
+    Resize(capacity);
+  };
+
+  size_type bucket_count() const { return capacity_; };
+
+  float load_factor() const {
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0;
+  };
+
+  float max_load_factor() const { return 0.875f; };
+
+ protected:
+  int8_t *ctrl_ = EmptyGroup();
+  value_type *slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  // How many more elements fit before the table must grow; deleted
+  // markers use it up as well.
+  size_type growth_left_ = 0;
+  hasher hash_;
+  key_equal equal_;
+
+  static const Key &KeyOf(const Key &key) { return key; };
+
+  template <class T>
+  static const Key &KeyOf(const std::pair<Key, T> &value) {
+    return value.first;
+  };
+
+  // Fibonacci hashing mixes the bits, as std::hash is the identity for
+  // integers. The low seven bits go to the control bytes, the rest pick
+  // the first group.
+  size_t HashOf(const Key &key) const {
+    uint64_t mixed = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(mixed ^ (mixed >> 32));
+  };
+
+  static int8_t H2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); };
+
+  // The slot holding key, or capacity_ if there is none.
+  size_type FindIndex(const Key &key, size_t hash) const {
+    size_type position = (hash >> 7) & capacity_;
+    for (size_type step = kGroupWidth;; step += kGroupWidth) {
+      Group group(ctrl_ + position);
+      for (uint32_t match = group.Match(H2(hash)); match; match &= match - 1) {
+        size_type index = (position + TrailingZeros(match)) & capacity_;
+        if (equal_(KeyOf(slots_[index]), key)) return index;
+      }
+      if (group.MatchEmpty()) return capacity_;
+      position = (position + step) & capacity_;
+    }
+  };
+
+  iterator Find(const Key &key) {
+    size_type index = FindIndex(key, HashOf(key));
+    return iterator(ctrl_ + index, slots_ + index);
+  };
+
+  // Inserts make() unless an element with key is present. make is only
+  // called when the key is missing.
+  template <class Make>
+  std::pair<iterator, bool> InsertUnique(const Key &key, Make make) {
+    size_t hash = HashOf(key);
+    size_type index = FindIndex(key, hash);
+    if (index != capacity_)
+      return std::pair<iterator, bool>(iterator(ctrl_ + index, slots_ + index),
+                                       false);
+    index = FirstFree(hash);
+    if (!growth_left_ && ctrl_[index] != kDeleted) {
+      Grow();
+      index = FirstFree(hash);
+    }
+    new (slots_ + index) value_type(make());
+    growth_left_ -= ctrl_[index] == kEmpty;
+    SetCtrl(index, H2(hash));
+    ++size_;
+    return std::pair<iterator, bool>(iterator(ctrl_ + index, slots_ + index),
+                                     true);
+  };
+
+ private:
+  // Up to seven eighths of the slots may be used, so probes always reach
+  // an empty slot.
+  static size_type GrowthFor(size_type capacity) {
+    return capacity - capacity / 8;
+  };
+
+  static size_type CapacityFor(size_type count) {
+    size_type capacity = kGroupWidth - 1;
+    while (GrowthFor(capacity) < count) capacity = capacity * 2 + 1;
+    return capacity;
+  };
+
+  // The first empty or deleted slot on the probe sequence of hash.
+  size_type FirstFree(size_t hash) const {
+    size_type position = (hash >> 7) & capacity_;
+    for (size_type step = kGroupWidth;; step += kGroupWidth) {
+      uint32_t free = Group(ctrl_ + position).MatchFree();
+      if (free) return (position + TrailingZeros(free)) & capacity_;
+      position = (position + step) & capacity_;
+    }
+  };
+
+  // Writes a control byte and its copy after the sentinel.
+  void SetCtrl(size_type index, int8_t h2) {
+    ctrl_[index] = h2;
+    ctrl_[((index - (kGroupWidth - 1)) & capacity_) + (kGroupWidth - 1)] = h2;
+  };
+
+  // Doubles the table, or only clears the deleted markers when they, not
+  // the elements, fill it.
+  void Grow() {
+    if (capacity_ && size_ <= GrowthFor(capacity_) / 2) {
+      Resize(capacity_);
+    } else {
+      Resize(capacity_ ? capacity_ * 2 + 1 : kGroupWidth - 1);
+    }
+  };
+
+  // Moves the elements into a new table, which frees what it holds should
+  // a transfer throw, and swaps it in once all are there. Elements whose
+  // move may throw are copied, so this table stays intact until then.
+  void Resize(size_type capacity) {
+    HashTable table;
+    table.Allocate(capacity);
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] < 0) continue;
+      size_t hash = HashOf(KeyOf(slots_[i]));
+      size_type index = table.FirstFree(hash);
+      new (table.slots_ + index) value_type(std::move_if_noexcept(slots_[i]));
+      table.SetCtrl(index, H2(hash));
+    }
+    table.size_ = size_;
+    table.growth_left_ -= size_;
+    swap(table);
+  };
+
+  // Leaves a table of capacity empty slots; the elements are the caller's.
+  void Allocate(size_type capacity) {
+    std::unique_ptr<int8_t[]> ctrl(new int8_t[capacity + kGroupWidth]);
+    slots_ = static_cast<value_type *>(
+        ::operator new(capacity * sizeof(value_type)));
+    ctrl_ = ctrl.release();
+    capacity_ = capacity;
+    ResetCtrl();
+    growth_left_ = GrowthFor(capacity);
+  };
+
+  void ResetCtrl() {
+    std::memset(ctrl_, kEmpty, capacity_ + kGroupWidth);
+    ctrl_[capacity_] = kSentinel;
+  };
+
+  void DestroyAll() {
+    for (size_type i = 0; i < capacity_; ++i)
+      if (ctrl_[i] >= 0) slots_[i].~value_type();
+  };
+
+  void Deallocate() {
+    if (capacity_) {
+      delete[] ctrl_;
+      ::operator delete(slots_);
+    }
+    ctrl_ = EmptyGroup();
+    slots_ = nullptr;
+    capacity_ = size_ = growth_left_ = 0;
+  };
+};
+
+#endif  // S21_CONTAINERS_HEADERS_S21_HASH_TABLE_H_
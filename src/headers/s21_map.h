@@ -2,12 +2,17 @@
 #define S21_CONTAINERS_HEADERS_S21_MAP_H_
 
 #include <iostream>
+#include <stdexcept>
+#include <tuple>
 
 #include "s21_binary_tree.h"
+#include "s21_frozen_map.h"
 
 namespace s21 {
-template <class Key, class T, class Compare = s21::PairComp<Key, T>>
-class Map : public BinaryTree<std::pair<Key, T>, Compare> {
+template <class Key, class T, class Compare = s21::PairComp<Key, T>,
+          template <class> class Allocator = s21::HeapAllocator,
+          bool Ranked = false>
+class Map : public BinaryTree<std::pair<Key, T>, Compare, Allocator, Ranked> {
  public:
   using key_type = Key;
   using mapped_type = T;
@@ -15,16 +20,18 @@ class Map : public BinaryTree<std::pair<Key, T>, Compare> {
   using key_compare = Compare;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using iterator = typename BinaryTree<value_type, key_compare>::Iterator;
-  using const_iterator =
-      typename BinaryTree<value_type, key_compare>::ConstIterator;
+  using tree = BinaryTree<value_type, key_compare, Allocator, Ranked>;
+  using iterator = typename tree::Iterator;
+  using const_iterator = typename tree::ConstIterator;
   using size_type = size_t;
-  using tree_node = typename BinaryTree<value_type, Compare>::Node;
+  using tree_node = typename tree::Node;
+  using node_type = typename tree::node_type;
+  using insert_return_type = typename tree::insert_return_type;
 
   Map() {
-    this->end_nil_ = new tree_node(value_type(0, 0));
-    this->begin_nil_ =
-        new tree_node(value_type(0, 0), nullptr, nullptr, this->end_nil_);
+    this->end_nil_ = new tree_node(value_type());
+    this->begin_nil_ = new tree_node(value_type());
+    this->begin_nil_->parent_ = this->end_nil_;
     this->end_nil_->parent_ = this->begin_nil_;
   };
 
@@ -32,10 +39,18 @@ class Map : public BinaryTree<std::pair<Key, T>, Compare> {
     for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
   };
 
-  Map(const Map &other) : Map() {
-    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+  template <class ForwardIt>
+  Map(s21::assume_sorted_t, ForwardIt first, ForwardIt last) : Map() {
+    this->AssignSorted(first, last);
+  };
+
+  Map(s21::assume_sorted_t, std::initializer_list<value_type> const &items)
+      : Map() {
+    this->AssignSorted(items.begin(), items.end());
   };
 
+  Map(const Map &other) : Map() { this->CloneFrom(other); };
+
   Map(Map &&other) : Map() { this->swap(other); };
 
   ~Map() {
@@ -51,67 +66,237 @@ class Map : public BinaryTree<std::pair<Key, T>, Compare> {
   };
 
   Map &operator=(const Map &other) {
-    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+    if (this != &other) {
+      this->clear();
+      this->CloneFrom(other);
+    }
     return *this;
   };
 
+  // Builds a map from a range of pairs sorted by unique keys in O(n).
+  template <class ForwardIt>
+  static Map from_sorted(ForwardIt first, ForwardIt last) {
+    return Map(s21::assume_sorted, first, last);
+  };
+
   T &operator[](const Key &key) {
-    auto it = this->begin();
-    while ((*it).first != key && it != this->end()) ++it;
-    if (it == this->end()) {
-      auto pair = this->insert(key, 0);
-      it = pair.first;
+    tree_node *node = this->root_;
+    int order = 0;
+    tree_node *parent = this->Search(Probe(key), node, order);
+    if (!this->IsNode(node)) {
+      tree_node *slot = node;
+      node = this->allocator_.Allocate(std::piecewise_construct,
+                                       std::forward_as_tuple(key),
+                                       std::forward_as_tuple());
+      this->Link(node, parent, slot, order);
     }
-    return (*it).second;
+    return node->data_.second;
   };
 
-  T &at(const Key &key) {
-    auto it = this->begin();
-    if (this->contains(key)) {
-      while ((*it).first != key) ++it;
-    } else {
-      throw std::out_of_range("s21::map::at");
-    }
-    return (*it).second;
+  template <class K>
+  T &at(const K &key) {
+    tree_node *node = this->Find(Probe(key));
+    if (!node) throw std::out_of_range("s21::map::at");
+    return node->data_.second;
   };
 
   std::pair<iterator, bool> insert(const value_type &value) {
     return this->InsertOrPaste(value);
   };
 
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return this->InsertUnique(
+        value, [&] { return this->allocator_.Allocate(std::move(value)); });
+  };
+
   std::pair<iterator, bool> insert(const Key &key, const T &obj) {
-    value_type tmp(key, obj);
-    std::pair<iterator, bool> answer = this->InsertOrPaste(tmp);
-    return answer;
+    return try_emplace(key, obj);
   };
 
-  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
-    value_type tmp(key, obj);
-    std::pair<iterator, bool> answer = this->InsertOrPaste(tmp);
-    if (!answer.second) (*answer.first).second = obj;
-    return answer;
+  // Inserts value in amortised O(1) when it belongs right before or right
+  // after hint, as when a sorted stream is inserted at end().
+  iterator insert(iterator hint, const value_type &value) {
+    return this->InsertNear(hint, value).first;
   };
 
-  void merge(Map &other) {
-    auto it = other.begin();
-    while (it != other.end()) {
-      auto tmp = it + 1;
-      if (!this->contains((*it).first)) {
-        other.DeleteOrExtract(it, false);
-        this->InsertOrPaste(*it, it.node());
-      }
-      it = tmp;
-    }
+  template <class... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    tree_node *node = this->allocator_.Allocate(std::forward<Args>(args)...);
+    return this->InsertNear(hint, node->data_, node).first;
+  };
+
+  // Builds the entry in its node; the node is freed again when the key is
+  // present.
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return this->EmplaceUnique(std::forward<Args>(args)...);
+  };
+
+  // Builds the mapped value from args only when key is missing; otherwise
+  // nothing is constructed and args are left untouched.
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return TryEmplace(key, std::forward<Args>(args)...);
   };
 
-  bool contains(const Key &key) {
-    bool answer = true;
-    auto it = this->begin();
-    while ((*it).first != key && it != this->end()) ++it;
-    if (it == this->end()) answer = false;
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return TryEmplace(std::move(key), std::forward<Args>(args)...);
+  };
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    return InsertOrAssign(key, std::forward<M>(obj));
+  };
+
+  template <class M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    return InsertOrAssign(std::move(key), std::forward<M>(obj));
+  };
+
+  // Inserts a batch with one sort and one ascending pass through the tree,
+  // each search starting from the previous insertion point. Results are in
+  // the order of the arguments; a duplicate key gets the entry
+  // already stored, whose mapped value is kept.
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return this->InsertMany(true, std::forward<Args>(args)...);
+  };
+
+  template <class InputIt>
+  std::vector<std::pair<iterator, bool>> insert_range(InputIt first,
+                                                      InputIt last) {
+    return this->InsertRange(true, first, last);
+  };
+
+  // Unlinks the entry at pos, or the one equal to key, without freeing
+  // it. An empty handle is returned when there is none.
+  node_type extract(iterator pos) { return this->Extract(pos); };
+
+  template <class K>
+  node_type extract(const K &key) {
+    tree_node *node = this->Find(Probe(key));
+    return node ? this->Extract(iterator(node)) : node_type();
+  };
+
+  // Links the node of an extracted handle in; on a clash the handle is
+  // handed back in the result.
+  insert_return_type insert(node_type &&handle) {
+    return this->Paste(std::move(handle));
+  };
+
+  // Moves the elements whose keys are missing here out of other in O(n + m).
+  void merge(Map &other) { this->MergeFrom(other); };
+
+  // Set algebra with other in O(n + m), replacing the contents of this
+  // map. Nodes already here are reused, so common keys keep the mapped
+  // values of this map.
+  void set_union(const Map &other) {
+    this->Combine(other, true, true, true);
+  };
+
+  void set_intersection(const Map &other) {
+    this->Combine(other, false, true, false);
+  };
+
+  void set_difference(const Map &other) {
+    this->Combine(other, true, false, false);
+  };
+
+  void set_symmetric_difference(const Map &other) {
+    this->Combine(other, true, false, true);
+  };
+
+  // An immutable copy laid out for fast queries; see FrozenMap.
+  s21::FrozenMap<Key, T, Compare> freeze() const {
+    return s21::FrozenMap<Key, T, Compare>(s21::assume_sorted, this->cbegin(),
+                                           this->cend());
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    tree_node *node = this->Find(Probe(key));
+    return node ? iterator(node) : this->end();
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  // find and contains for every key of [first, last), written to out in
+  // order. The lookups advance in groups, so that their cache misses
+  // overlap; this pays off on trees much larger than the caches.
+  template <class InputIt, class OutputIt>
+  OutputIt find_many(InputIt first, InputIt last, OutputIt out) {
+    auto probe = [](const auto &key) -> decltype(auto) { return Probe(key); };
+    this->FindMany(first, last, probe, [&](tree_node *node) {
+      *out++ = node ? iterator(node) : this->end();
+    });
+    return out;
+  };
+
+  template <class InputIt, class OutputIt>
+  OutputIt contains_many(InputIt first, InputIt last, OutputIt out) {
+    auto probe = [](const auto &key) -> decltype(auto) { return Probe(key); };
+    this->FindMany(first, last, probe,
+                   [&](tree_node *node) { *out++ = node != nullptr; });
+    return out;
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return iterator(this->LowerBound(Probe(key)));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return iterator(this->UpperBound(Probe(key)));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return this->EqualRange(Probe(key));
+  };
+
+  template <class K>
+  size_type rank(const K &key) {
+    return this->Rank(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::PairProbe<Key, T, Compare>(key);
+  };
+
+  template <class K, class... Args>
+  std::pair<iterator, bool> TryEmplace(K &&key, Args &&...args) {
+    return this->InsertUnique(s21::InsertProbe<Key, T, Compare>(key), [&] {
+      return this->allocator_.Allocate(
+          std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    });
+  };
+
+  template <class K, class M>
+  std::pair<iterator, bool> InsertOrAssign(K &&key, M &&obj) {
+    std::pair<iterator, bool> answer =
+        TryEmplace(std::forward<K>(key), std::forward<M>(obj));
+    if (!answer.second) (*answer.first).second = std::forward<M>(obj);
     return answer;
   };
 };
+
+// Map with subtree sizes: nth, rank and iterator jumps take O(log n).
+template <class Key, class T, class Compare = s21::PairComp<Key, T>>
+using RankedMap = Map<Key, T, Compare, s21::HeapAllocator, true>;
 }  // namespace s21
 
 #endif  // S21_CONTAINERS_HEADERS_S21_MAP_H_
@@ -0,0 +1,119 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_MULTIMAP_H_
+#define S21_CONTAINERS_HEADERS_S21_MULTIMAP_H_
+
+#include <iostream>
+
+#include "s21_binary_tree.h"
+
+namespace s21 {
+// Map that keeps equal keys, each pair in a node of its own, in insertion
+// order.
+template <class Key, class T, class Compare = s21::PairComp<Key, T>,
+          template <class> class Allocator = s21::HeapAllocator>
+class Multimap : public BinaryTree<std::pair<Key, T>, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using tree = BinaryTree<value_type, key_compare, Allocator>;
+  using iterator = typename tree::Iterator;
+  using const_iterator = typename tree::ConstIterator;
+  using size_type = size_t;
+  using tree_node = typename tree::Node;
+
+  Multimap() {
+    this->end_nil_ = new tree_node(value_type());
+    this->begin_nil_ = new tree_node(value_type());
+    this->begin_nil_->parent_ = this->end_nil_;
+    this->end_nil_->parent_ = this->begin_nil_;
+  };
+
+  Multimap(std::initializer_list<value_type> const &items) : Multimap() {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  Multimap(const Multimap &other) : Multimap() { this->CloneFrom(other); };
+
+  Multimap(Multimap &&other) : Multimap() { this->swap(other); };
+
+  ~Multimap() {
+    this->clear();
+    delete this->end_nil_;
+    delete this->begin_nil_;
+  };
+
+  Multimap &operator=(Multimap &&other) {
+    this->clear();
+    this->swap(other);
+    return *this;
+  };
+
+  Multimap &operator=(const Multimap &other) {
+    if (this != &other) {
+      this->clear();
+      this->CloneFrom(other);
+    }
+    return *this;
+  };
+
+  iterator insert(const value_type &value) {
+    return this->InsertEqual(value);
+  };
+
+  iterator insert(const Key &key, const T &obj) {
+    return this->InsertEqual(value_type(key, obj));
+  };
+
+  // Moves all elements of other here in O(n + m).
+  void merge(Multimap &other) { this->MergeFrom(other, true); };
+
+  // Lookups accept any key type the comparator can compare with Key. find
+  // gives the first of the pairs with that key.
+  template <class K>
+  iterator find(const K &key) {
+    iterator it = lower_bound(key);
+    return it != this->end() && !this->Order(Probe(key), *it) ? it
+                                                               : this->end();
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    size_type count = 0;
+    for (auto range = equal_range(key); range.first != range.second;
+         ++range.first)
+      ++count;
+    return count;
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return iterator(this->LowerBound(Probe(key)));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return iterator(this->UpperBound(Probe(key)));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::PairProbe<Key, T, Compare>(key);
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_MULTIMAP_H_
@@ -0,0 +1,408 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_MULTISET_H_
+#define S21_CONTAINERS_HEADERS_S21_MULTISET_H_
+
+#include <iostream>
+#include <iterator>
+
+#include "s21_binary_tree.h"
+
+namespace s21 {
+// Set that keeps equal keys, each in a node of its own, in insertion order.
+// With RunLength, equal keys share one node holding their count instead;
+// see the specialization below.
+template <typename Key, class Compare = s21::SingleComp<Key>,
+          template <class> class Allocator = s21::HeapAllocator,
+          bool RunLength = false>
+class Multiset : public BinaryTree<Key, Compare, Allocator> {
+ public:
+  using key_type = Key;
+  using tree = BinaryTree<Key, Compare, Allocator>;
+  using value_type = typename tree::value_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using iterator = typename tree::Iterator;
+  using const_iterator = typename tree::ConstIterator;
+  using tree_node = typename tree::Node;
+
+  Multiset() {
+    this->end_nil_ = new tree_node(key_type());
+    this->begin_nil_ = new tree_node(key_type());
+    this->begin_nil_->parent_ = this->end_nil_;
+    this->end_nil_->parent_ = this->begin_nil_;
+  };
+
+  Multiset(std::initializer_list<value_type> const &items) : Multiset() {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  Multiset(const Multiset &other) : Multiset() { this->CloneFrom(other); };
+
+  Multiset(Multiset &&other) : Multiset() { this->swap(other); };
+
+  ~Multiset() {
+    this->clear();
+    delete this->end_nil_;
+    delete this->begin_nil_;
+  };
+
+  Multiset &operator=(Multiset &&other) {
+    this->clear();
+    this->swap(other);
+    return *this;
+  };
+
+  Multiset &operator=(const Multiset &other) {
+    if (this != &other) {
+      this->clear();
+      this->CloneFrom(other);
+    }
+    return *this;
+  };
+
+  iterator insert(const value_type &value) {
+    return this->InsertEqual(value);
+  };
+
+  // Inserts a batch with one sort and one ascending pass through the tree,
+  // each search starting from the previous insertion point. Results are in
+  // the order of the arguments, and every element is inserted.
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return this->InsertMany(false, std::forward<Args>(args)...);
+  };
+
+  template <class InputIt>
+  std::vector<std::pair<iterator, bool>> insert_range(InputIt first,
+                                                      InputIt last) {
+    return this->InsertRange(false, first, last);
+  };
+
+  // Moves all elements of other here in O(n + m).
+  void merge(Multiset &other) { this->MergeFrom(other, true); };
+
+  // Lookups accept any key type the comparator can compare with Key. find
+  // gives the first of the equal elements.
+  template <class K>
+  iterator find(const K &key) {
+    iterator it = lower_bound(key);
+    return it != this->end() && !this->Order(Probe(key), *it) ? it
+                                                               : this->end();
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    size_type count = 0;
+    for (auto range = equal_range(key); range.first != range.second;
+         ++range.first)
+      ++count;
+    return count;
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return iterator(this->LowerBound(Probe(key)));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return iterator(this->UpperBound(Probe(key)));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::KeyProbe<Key, Compare>(key);
+  };
+};
+
+// Orders (key, count) runs by their keys with the comparator of the keys.
+template <class Key, class KeyCompare>
+struct RunComp {
+  using run = std::pair<Key, size_t>;
+
+  template <class L, class R>
+  int Compare(const L &a, const R &b) const {
+    return s21::Order(compare, KeyOf(a), KeyOf(b));
+  };
+  template <class L, class R>
+  bool LessThan(const L &a, const R &b) const {
+    return Compare(a, b) < 0;
+  };
+  template <class L, class R>
+  bool GreaterThan(const L &a, const R &b) const {
+    return Compare(a, b) > 0;
+  };
+
+  static const Key &KeyOf(const run &a) { return a.first; };
+  template <class K>
+  static const K &KeyOf(const K &key) {
+    return key;
+  };
+
+  KeyCompare compare;
+};
+
+// Run-length multiset: one node per distinct key, holding how many equal
+// keys were inserted. Heavily repeated keys cost no extra nodes, and count
+// takes O(log n). Elements are not modifiable through iterators.
+template <typename Key, class Compare, template <class> class Allocator>
+class Multiset<Key, Compare, Allocator, true>
+    : protected BinaryTree<std::pair<Key, size_t>, RunComp<Key, Compare>,
+                           Allocator> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using tree =
+      BinaryTree<std::pair<Key, size_t>, RunComp<Key, Compare>, Allocator>;
+  using tree_node = typename tree::Node;
+
+  // Walks every copy of each key: (run, index within the run).
+  class RunIterator {
+   public:
+    RunIterator(){};
+    RunIterator(typename tree::Iterator run, size_type index)
+        : run_(run), index_(index){};
+
+    const_reference operator*() const { return (*run_).first; };
+
+    RunIterator &operator++() {
+      if (++index_ == (*run_).second) {
+        ++run_;
+        index_ = 0;
+      }
+      return *this;
+    };
+
+    RunIterator operator++(int) {
+      RunIterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    RunIterator &operator--() {
+      if (index_) {
+        --index_;
+      } else {
+        --run_;
+        index_ = (*run_).second - 1;
+      }
+      return *this;
+    };
+
+    RunIterator operator--(int) {
+      RunIterator tmp = *this;
+      --*this;
+      return tmp;
+    };
+
+    bool operator==(const RunIterator &other) const {
+      return run_.node() == other.run_.node() && index_ == other.index_;
+    };
+
+    bool operator!=(const RunIterator &other) const {
+      return !(*this == other);
+    };
+
+    typename tree::Iterator run() const { return run_; };
+    size_type index() const { return index_; };
+
+   private:
+    typename tree::Iterator run_;
+    size_type index_ = 0;
+  };
+
+  using iterator = RunIterator;
+  using const_iterator = RunIterator;
+
+  Multiset() {
+    this->end_nil_ = new tree_node(typename tree::value_type());
+    this->begin_nil_ = new tree_node(typename tree::value_type());
+    this->begin_nil_->parent_ = this->end_nil_;
+    this->end_nil_->parent_ = this->begin_nil_;
+  };
+
+  Multiset(std::initializer_list<value_type> const &items) : Multiset() {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  Multiset(const Multiset &other) : Multiset() {
+    this->CloneFrom(other);
+    count_ = other.count_;
+  };
+
+  Multiset(Multiset &&other) : Multiset() { swap(other); };
+
+  ~Multiset() {
+    clear();
+    delete this->end_nil_;
+    delete this->begin_nil_;
+  };
+
+  Multiset &operator=(Multiset &&other) {
+    clear();
+    swap(other);
+    return *this;
+  };
+
+  Multiset &operator=(const Multiset &other) {
+    if (this != &other) {
+      clear();
+      this->CloneFrom(other);
+      count_ = other.count_;
+    }
+    return *this;
+  };
+
+  iterator begin() { return iterator(tree::begin(), 0); };
+
+  iterator end() { return iterator(tree::end(), 0); };
+
+  bool empty() const { return !count_; };
+
+  size_type size() const { return count_; };
+
+  using tree::max_size;
+
+  // The number of distinct keys, which is the number of nodes.
+  size_type distinct() const { return tree::size(); };
+
+  void clear() {
+    tree::clear();
+    count_ = 0;
+  };
+
+  iterator insert(const value_type &value) {
+    auto answer = this->InsertOrPaste(run(value, 1));
+    if (!answer.second) ++(*answer.first).second;
+    ++count_;
+    return iterator(answer.first, (*answer.first).second - 1);
+  };
+
+  // Inserts a batch with one sort and one pass through the tree, as the
+  // other multiset does. Keys already present, here or earlier in the
+  // batch, only add to the count of their run. Results are in the order of
+  // the arguments, and every element is inserted.
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    std::vector<std::pair<iterator, bool>> results;
+    results.reserve(sizeof...(args));
+    CountBatch(this->InsertMany(true, run(std::forward<Args>(args), 1)...),
+               results);
+    return results;
+  };
+
+  template <class InputIt>
+  std::vector<std::pair<iterator, bool>> insert_range(InputIt first,
+                                                      InputIt last) {
+    std::vector<run> runs;
+    for (; first != last; ++first) runs.emplace_back(*first, 1);
+    std::vector<std::pair<iterator, bool>> results;
+    results.reserve(runs.size());
+    CountBatch(this->InsertRange(true, std::make_move_iterator(runs.begin()),
+                                 std::make_move_iterator(runs.end())),
+               results);
+    return results;
+  };
+
+  // Returns the iterator following the erased element.
+  iterator erase(iterator pos) {
+    typename tree::Iterator run = pos.run();
+    --count_;
+    if (--(*run).second) {
+      return pos.index() < (*run).second ? pos : iterator(++run, 0);
+    }
+    return iterator(tree::erase(run), 0);
+  };
+
+  void swap(Multiset &other) {
+    tree::swap(other);
+    std::swap(count_, other.count_);
+  };
+
+  // Moves all elements of other here in O(n + m); runs of keys present in
+  // both trees are added up.
+  void merge(Multiset &other) {
+    if (this == &other) return;
+    this->MergeFrom(other, false, [](run &own, const run &theirs) {
+      own.second += theirs.second;
+    });
+    count_ += other.count_;
+    other.count_ = 0;
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    tree_node *node = this->Find(Probe(key));
+    return iterator(node ? typename tree::Iterator(node) : tree::end(), 0);
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    tree_node *node = this->Find(Probe(key));
+    return node ? node->data_.second : 0;
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return iterator(typename tree::Iterator(this->LowerBound(Probe(key))), 0);
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return iterator(typename tree::Iterator(this->UpperBound(Probe(key))), 0);
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+  };
+
+ private:
+  using run = typename tree::value_type;
+
+  size_type count_ = 0;
+
+  // Points the results at the copies a batch added, growing the runs that
+  // were there before.
+  void CountBatch(
+      const std::vector<std::pair<typename tree::Iterator, bool>> &placed,
+      std::vector<std::pair<iterator, bool>> &results) {
+    for (const auto &answer : placed) {
+      size_type index = answer.second ? 0 : (*answer.first).second++;
+      results.emplace_back(iterator(answer.first, index), true);
+    }
+    count_ += placed.size();
+  };
+
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::KeyProbe<Key, Compare>(key);
+  };
+};
+
+// Multiset storing each distinct key once with its count.
+template <typename Key, class Compare = s21::SingleComp<Key>>
+using RunLengthMultiset = Multiset<Key, Compare, s21::HeapAllocator, true>;
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_MULTISET_H_
@@ -0,0 +1,476 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_PERSISTENT_MAP_H_
+#define S21_CONTAINERS_HEADERS_S21_PERSISTENT_MAP_H_
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_epoch.h"
+
+namespace s21 {
+template <class Key, class T, class Compare>
+class AtomicPersistentMap;
+
+// Immutable map: insert and erase leave the map alone and return a new
+// version of it. Versions are trees of reference-counted nodes that never
+// change once built, balanced like AVL trees except that sibling heights
+// may differ by up to 2, which still keeps them O(log n) deep. A new
+// version copies only the path from the root to the changed node and
+// shares every other subtree with the old one, so an update costs
+// O(log n) time and memory and copying a version costs one reference
+// count. Versions may be read by any number of threads at once.
+template <class Key, class T, class Compare = s21::PairComp<Key, T>>
+class PersistentMap {
+  struct Node;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+  // Nodes have no parent links, so stepping forward searches the version
+  // from its root with the version's comparator: O(log n) per step. The
+  // version must outlive the iterator.
+  class ConstIterator {
+   public:
+    ConstIterator() : root_(nullptr), node_(nullptr), comparator_(nullptr){};
+    ConstIterator(const Node *root, const Node *node,
+                  const key_compare &comparator)
+        : root_(root), node_(node), comparator_(&comparator){};
+
+    const_reference operator*() const { return node_->data_; };
+
+    ConstIterator &operator++() {
+      if (node_->right_) {
+        node_ = Leftmost(node_->right_);
+      } else {
+        node_ = Above(root_, node_->data_, *comparator_);
+      }
+      return *this;
+    };
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    bool operator==(const ConstIterator &other) const {
+      return node_ == other.node_;
+    };
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    };
+
+   private:
+    const Node *root_;
+    const Node *node_;
+    const key_compare *comparator_;
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  PersistentMap(){};
+
+  PersistentMap(std::initializer_list<value_type> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it)
+      *this = insert(*it);
+  };
+
+  PersistentMap(const PersistentMap &other)
+      : root_(Share(other.root_)), comparator(other.comparator){};
+
+  PersistentMap(PersistentMap &&other)
+      : root_(other.root_), comparator(other.comparator) {
+    other.root_ = nullptr;
+  };
+
+  ~PersistentMap() { Release(root_); };
+
+  PersistentMap &operator=(const PersistentMap &other) {
+    Node *root = Share(other.root_);
+    Release(root_);
+    root_ = root;
+    comparator = other.comparator;
+    return *this;
+  };
+
+  PersistentMap &operator=(PersistentMap &&other) {
+    std::swap(root_, other.root_);
+    std::swap(comparator, other.comparator);
+    return *this;
+  };
+
+  const_iterator begin() const {
+    return const_iterator(root_, root_ ? Leftmost(root_) : nullptr,
+                          comparator);
+  };
+
+  const_iterator end() const {
+    return const_iterator(root_, nullptr, comparator);
+  };
+
+  bool empty() const { return !root_; };
+
+  size_type size() const { return Size(root_); };
+
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  };
+
+  // The version with value added, or this one if its key is present. New
+  // versions keep the comparator of this one.
+  PersistentMap insert(const value_type &value) const {
+    return PersistentMap(Insert(root_, value, false), comparator);
+  };
+
+  PersistentMap insert(const Key &key, const T &obj) const {
+    return insert(value_type(key, obj));
+  };
+
+  PersistentMap insert_or_assign(const Key &key, const T &obj) const {
+    return PersistentMap(Insert(root_, value_type(key, obj), true),
+                         comparator);
+  };
+
+  // The version without key, or this one if key is missing.
+  template <class K>
+  PersistentMap erase(const K &key) const {
+    return PersistentMap(Erase(root_, Probe(key)), comparator);
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  const T &at(const K &key) const {
+    const Node *node = Find(Probe(key));
+    if (!node) throw std::out_of_range("s21::persistent_map::at");
+    return node->data_.second;
+  };
+
+  template <class K>
+  const_iterator find(const K &key) const {
+    return const_iterator(root_, Find(Probe(key)), comparator);
+  };
+
+  template <class K>
+  bool contains(const K &key) const {
+    return Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) const {
+    return contains(key);
+  };
+
+  template <class K>
+  const_iterator lower_bound(const K &key) const {
+    const Node *bound = nullptr;
+    for (const Node *node = root_; node;) {
+      if (Order(node->data_, Probe(key)) < 0) {
+        node = node->right_;
+      } else {
+        bound = node;
+        node = node->left_;
+      }
+    }
+    return const_iterator(root_, bound, comparator);
+  };
+
+  template <class K>
+  const_iterator upper_bound(const K &key) const {
+    return const_iterator(root_, Above(root_, Probe(key), comparator),
+                          comparator);
+  };
+
+ private:
+  friend class AtomicPersistentMap<Key, T, Compare>;
+
+  struct Node {
+    Node(const value_type &data, Node *left, Node *right)
+        : data_(data),
+          left_(left),
+          right_(right),
+          height_(std::max(Height(left), Height(right)) + 1),
+          size_(Size(left) + Size(right) + 1){};
+
+    const value_type data_;
+    Node *const left_;
+    Node *const right_;
+    const int height_;
+    const size_type size_;
+    std::atomic<size_type> refs_{1};
+  };
+
+  Node *root_ = nullptr;
+  key_compare comparator;
+
+  // Adopts the reference to root.
+  explicit PersistentMap(Node *root,
+                         const key_compare &comparator = key_compare())
+      : root_(root), comparator(comparator){};
+
+  template <class L, class R>
+  int Order(const L &a, const R &b) const {
+    return s21::Order(comparator, a, b);
+  };
+
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::PairProbe<Key, T, Compare>(key);
+  };
+
+  static int Height(const Node *node) { return node ? node->height_ : 0; };
+
+  static size_type Size(const Node *node) { return node ? node->size_ : 0; };
+
+  static const Node *Leftmost(const Node *node) {
+    while (node->left_) node = node->left_;
+    return node;
+  };
+
+  // The first node greater than key.
+  template <class K>
+  static const Node *Above(const Node *node, const K &key,
+                           const key_compare &comparator) {
+    const Node *bound = nullptr;
+    while (node) {
+      if (s21::Order(comparator, key, node->data_) < 0) {
+        bound = node;
+        node = node->left_;
+      } else {
+        node = node->right_;
+      }
+    }
+    return bound;
+  };
+
+  template <class K>
+  const Node *Find(const K &key) const {
+    const Node *node = root_;
+    while (node) {
+      int order = Order(key, node->data_);
+      if (!order) return node;
+      node = order < 0 ? node->left_ : node->right_;
+    }
+    return nullptr;
+  };
+
+  // Reference counting. Functions below return nodes the caller owns a
+  // reference to. They read the nodes they are passed and take references
+  // out of the Refs they are given; the caller's Refs release whatever is
+  // left, so a throw partway through leaks no reference.
+  static Node *Share(Node *node) {
+    if (node) node->refs_.fetch_add(1, std::memory_order_relaxed);
+    return node;
+  };
+
+  static void Release(Node *node) {
+    if (node && node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      Release(node->left_);
+      Release(node->right_);
+      delete node;
+    }
+  };
+
+  // Owns one reference until Take hands it on.
+  class Ref {
+   public:
+    explicit Ref(Node *node) : node_(node){};
+    Ref(const Ref &other) = delete;
+    Ref &operator=(const Ref &other) = delete;
+    ~Ref() { Release(node_); };
+
+    Node *Get() const { return node_; };
+
+    Node *Take() { return std::exchange(node_, nullptr); };
+
+   private:
+    Node *node_;
+  };
+
+  // A new node over left and right, taking their references once built.
+  static Node *Make(const value_type &data, Ref &left, Ref &right) {
+    Node *node = new Node(data, left.Get(), right.Get());
+    left.Take();
+    right.Take();
+    return node;
+  };
+
+  // Builds a node over left and right, whose heights differ by up to 3,
+  // rotating once or twice so that they differ by at most 2.
+  static Node *Balance(Ref &left, const value_type &data, Ref &right) {
+    int left_height = Height(left.Get());
+    int right_height = Height(right.Get());
+    if (left_height > right_height + 2) {
+      const Node *top = left.Get();
+      const Node *inner = top->right_;
+      Ref outer(Share(top->left_));
+      if (Height(outer.Get()) >= Height(inner)) {
+        Ref middle(Share(top->right_));
+        Ref lower(Make(data, middle, right));
+        return Make(top->data_, outer, lower);
+      }
+      Ref inner_left(Share(inner->left_));
+      Ref inner_right(Share(inner->right_));
+      Ref lower_left(Make(top->data_, outer, inner_left));
+      Ref lower_right(Make(data, inner_right, right));
+      return Make(inner->data_, lower_left, lower_right);
+    }
+    if (right_height > left_height + 2) {
+      const Node *top = right.Get();
+      const Node *inner = top->left_;
+      Ref outer(Share(top->right_));
+      if (Height(outer.Get()) >= Height(inner)) {
+        Ref middle(Share(top->left_));
+        Ref lower(Make(data, left, middle));
+        return Make(top->data_, lower, outer);
+      }
+      Ref inner_left(Share(inner->left_));
+      Ref inner_right(Share(inner->right_));
+      Ref lower_left(Make(data, left, inner_left));
+      Ref lower_right(Make(top->data_, inner_right, outer));
+      return Make(inner->data_, lower_left, lower_right);
+    }
+    return Make(data, left, right);
+  };
+
+  // Builds node again over child in place of the side it came from.
+  static Node *Rebuild(const Node *node, Ref &child, bool left_side) {
+    Ref other(Share(left_side ? node->right_ : node->left_));
+    return left_side ? Balance(child, node->data_, other)
+                     : Balance(other, node->data_, child);
+  };
+
+  // Returns node itself, shared, when nothing changes.
+  Node *Insert(Node *node, const value_type &value, bool assign) const {
+    if (!node) return new Node(value, nullptr, nullptr);
+    int order = Order(value, node->data_);
+    if (!order) {
+      if (!assign) return Share(node);
+      Ref left(Share(node->left_));
+      Ref right(Share(node->right_));
+      return Make(value, left, right);
+    }
+    Node *side = order < 0 ? node->left_ : node->right_;
+    Ref child(Insert(side, value, assign));
+    if (child.Get() == side) return Share(node);
+    return Rebuild(node, child, order < 0);
+  };
+
+  template <class K>
+  Node *Erase(Node *node, const K &key) const {
+    if (!node) return nullptr;
+    int order = Order(key, node->data_);
+    if (!order) {
+      Ref left(Share(node->left_));
+      Ref right(Share(node->right_));
+      return Join(left, right);
+    }
+    Node *side = order < 0 ? node->left_ : node->right_;
+    Ref child(Erase(side, key));
+    if (child.Get() == side) return Share(node);
+    return Rebuild(node, child, order < 0);
+  };
+
+  // Joins two balanced trees, every key of left less than every key of
+  // right, whose heights differ by at most 2.
+  static Node *Join(Ref &left, Ref &right) {
+    if (!left.Get()) return right.Take();
+    if (!right.Get()) return left.Take();
+    Ref rest(WithoutMin(right.Get()));
+    return Balance(left, Leftmost(right.Get())->data_, rest);
+  };
+
+  static Node *WithoutMin(const Node *node) {
+    if (!node->left_) return Share(node->right_);
+    Ref rest(WithoutMin(node->left_));
+    Ref right(Share(node->right_));
+    return Balance(rest, node->data_, right);
+  };
+};
+
+// One current version of a PersistentMap shared between threads. Readers
+// take the current version with one atomic load and then read it without
+// any locks for as long as they like; writers publish new versions. A
+// replaced version is released once no reader can be loading it any more.
+template <class Key, class T, class Compare = s21::PairComp<Key, T>>
+class AtomicPersistentMap {
+ public:
+  using map_type = PersistentMap<Key, T, Compare>;
+
+  AtomicPersistentMap(){};
+
+  explicit AtomicPersistentMap(map_type map) : root_(map.root_) {
+    map.root_ = nullptr;
+  };
+
+  AtomicPersistentMap(const AtomicPersistentMap &other) = delete;
+  AtomicPersistentMap &operator=(const AtomicPersistentMap &other) = delete;
+
+  // No other thread may use the map any more.
+  ~AtomicPersistentMap() { map_type::Release(root_.load()); };
+
+  map_type load() const {
+    s21::EpochDomain::Guard guard = s21::EpochDomain::Instance().Pin();
+    return map_type(map_type::Share(root_.load()));
+  };
+
+  // Calls function(const map_type &) on the current version without taking
+  // a reference to it, so that readers write no memory they share; the
+  // version must not outlive the call unless function copies it.
+  template <class Function>
+  decltype(auto) read(Function &&function) const {
+    s21::EpochDomain::Guard guard = s21::EpochDomain::Instance().Pin();
+    struct Borrowed {
+      map_type map;
+      ~Borrowed() { map.root_ = nullptr; };
+    } borrowed{map_type(root_.load())};
+    return function(static_cast<const map_type &>(borrowed.map));
+  };
+
+  void store(map_type map) {
+    Retire(root_.exchange(map.root_));
+    map.root_ = nullptr;
+  };
+
+  // Stores update(current version), calling it again if another writer
+  // stored a version meanwhile. Returns the version stored.
+  template <class Update>
+  map_type update(Update &&update) {
+    for (;;) {
+      map_type current = load();
+      map_type next = update(current);
+      Node *expected = current.root_;
+      Node *desired = map_type::Share(next.root_);
+      if (root_.compare_exchange_strong(expected, desired)) {
+        Retire(expected);
+        return next;
+      }
+      map_type::Release(desired);
+    }
+  };
+
+ private:
+  using Node = typename map_type::Node;
+
+  std::atomic<Node *> root_{nullptr};
+
+  static void Retire(Node *root) {
+    if (!root) return;
+    s21::EpochDomain::Instance().Retire(root, [](void *node) {
+      map_type::Release(static_cast<Node *>(node));
+    });
+  };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_PERSISTENT_MAP_H_
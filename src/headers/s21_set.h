@@ -4,23 +4,30 @@
 #include <iostream>
 
 #include "s21_binary_tree.h"
+#include "s21_frozen_set.h"
 
 namespace s21 {
-template <typename Key, class Compare = s21::SingleComp<Key>>
-class Set : public BinaryTree<Key, Compare> {
+template <typename Key, class Compare = s21::SingleComp<Key>,
+          template <class> class Allocator = s21::HeapAllocator,
+          bool Ranked = false>
+class Set : public BinaryTree<Key, Compare, Allocator, Ranked> {
  public:
   using key_type = Key;
-  using value_type = typename BinaryTree<Key>::value_type;
-  using reference = typename BinaryTree<Key>::value_type &;
-  using const_reference = const typename BinaryTree<Key>::value_type &;
+  using tree = BinaryTree<Key, Compare, Allocator, Ranked>;
+  using value_type = typename tree::value_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
   using size_type = size_t;
-  using iterator = typename BinaryTree<Key>::Iterator;
-  using const_iterator = typename BinaryTree<Key>::ConstIterator;
-  using tree_node = typename BinaryTree<Key, Compare>::Node;
+  using iterator = typename tree::Iterator;
+  using const_iterator = typename tree::ConstIterator;
+  using tree_node = typename tree::Node;
+  using node_type = typename tree::node_type;
+  using insert_return_type = typename tree::insert_return_type;
 
   Set() {
-    this->end_nil_ = new tree_node(0);
-    this->begin_nil_ = new tree_node(0, nullptr, nullptr, this->end_nil_);
+    this->end_nil_ = new tree_node(key_type());
+    this->begin_nil_ = new tree_node(key_type());
+    this->begin_nil_->parent_ = this->end_nil_;
     this->end_nil_->parent_ = this->begin_nil_;
   };
 
@@ -28,10 +35,18 @@ class Set : public BinaryTree<Key, Compare> {
     for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
   };
 
-  Set(const Set &other) : Set() {
-    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+  template <class ForwardIt>
+  Set(s21::assume_sorted_t, ForwardIt first, ForwardIt last) : Set() {
+    this->AssignSorted(first, last);
+  };
+
+  Set(s21::assume_sorted_t, std::initializer_list<value_type> const &items)
+      : Set() {
+    this->AssignSorted(items.begin(), items.end());
   };
 
+  Set(const Set &other) : Set() { this->CloneFrom(other); };
+
   Set(Set &&other) : Set() { this->swap(other); };
 
   ~Set() {
@@ -47,45 +62,171 @@ class Set : public BinaryTree<Key, Compare> {
   };
 
   Set &operator=(const Set &other) {
-    this->clear();
-    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+    if (this != &other) {
+      this->clear();
+      this->CloneFrom(other);
+    }
     return *this;
   };
 
+  // Builds a set from a sorted range of unique keys in O(n).
+  template <class ForwardIt>
+  static Set from_sorted(ForwardIt first, ForwardIt last) {
+    return Set(s21::assume_sorted, first, last);
+  };
+
   std::pair<iterator, bool> insert(const value_type &value) {
     return this->InsertOrPaste(value);
   };
 
-  void merge(Set &other) {
-    auto it = other.begin();
-    while (it != other.end()) {
-      auto tmp = it + 1;
-      if (!this->contains(*it)) {
-        other.DeleteOrExtract(it, false);
-        this->InsertOrPaste(*it, it.node());
-      }
-      it = tmp;
-    }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return this->InsertUnique(
+        value, [&] { return this->allocator_.Allocate(std::move(value)); });
   };
 
-  iterator find(const Key &key) {
-    auto it = this->end();
-    if (this->contains(key)) {
-      it = this->begin();
-      while (*it != key) ++it;
-    }
-    return it;
-  };
-
-  bool contains(const Key &key) {
-    tree_node *tmp = this->root_;
-    bool answer = false;
-    this->Search(key, tmp);
-    if (tmp && tmp != this->end_nil_ && tmp != this->begin_nil_ &&
-        tmp->data_ == key)
-      answer = true;
-    return answer;
-  }
+  // Builds the element in its node; the node is freed again when an equal
+  // element is present.
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return this->EmplaceUnique(std::forward<Args>(args)...);
+  };
+
+  // Inserts value in amortised O(1) when it belongs right before or right
+  // after hint, as when a sorted stream is inserted at end().
+  iterator insert(iterator hint, const value_type &value) {
+    return this->InsertNear(hint, value).first;
+  };
+
+  template <class... Args>
+  iterator emplace_hint(iterator hint, Args &&...args) {
+    tree_node *node = this->allocator_.Allocate(std::forward<Args>(args)...);
+    return this->InsertNear(hint, node->data_, node).first;
+  };
+
+  // Inserts a batch with one sort and one ascending pass through the tree,
+  // each search starting from the previous insertion point. Results are in
+  // the order of the arguments; a duplicate gets the element it
+  // duplicates.
+  template <class... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
+    return this->InsertMany(true, std::forward<Args>(args)...);
+  };
+
+  template <class InputIt>
+  std::vector<std::pair<iterator, bool>> insert_range(InputIt first,
+                                                      InputIt last) {
+    return this->InsertRange(true, first, last);
+  };
+
+  // Unlinks the element at pos, or the one equal to key, without freeing
+  // it. An empty handle is returned when there is none.
+  node_type extract(iterator pos) { return this->Extract(pos); };
+
+  template <class K>
+  node_type extract(const K &key) {
+    tree_node *node = this->Find(Probe(key));
+    return node ? this->Extract(iterator(node)) : node_type();
+  };
+
+  // Links the node of an extracted handle in; on a clash the handle is
+  // handed back in the result.
+  insert_return_type insert(node_type &&handle) {
+    return this->Paste(std::move(handle));
+  };
+
+  // Moves the elements missing here out of other in O(n + m).
+  void merge(Set &other) { this->MergeFrom(other); };
+
+  // Set algebra with other in O(n + m), replacing the contents of this
+  // set. Nodes already here are reused.
+  void set_union(const Set &other) {
+    this->Combine(other, true, true, true);
+  };
+
+  void set_intersection(const Set &other) {
+    this->Combine(other, false, true, false);
+  };
+
+  void set_difference(const Set &other) {
+    this->Combine(other, true, false, false);
+  };
+
+  void set_symmetric_difference(const Set &other) {
+    this->Combine(other, true, false, true);
+  };
+
+  // An immutable copy laid out for fast queries; see FrozenSet.
+  s21::FrozenSet<Key, Compare> freeze() const {
+    return s21::FrozenSet<Key, Compare>(s21::assume_sorted, this->cbegin(),
+                                        this->cend());
+  };
+
+  // Lookups accept any key type the comparator can compare with Key.
+  template <class K>
+  iterator find(const K &key) {
+    tree_node *node = this->Find(Probe(key));
+    return node ? iterator(node) : this->end();
+  };
+
+  template <class K>
+  bool contains(const K &key) {
+    return this->Find(Probe(key)) != nullptr;
+  };
+
+  template <class K>
+  size_type count(const K &key) {
+    return contains(key);
+  };
+
+  // find and contains for every key of [first, last), written to out in
+  // order. The lookups advance in groups, so that their cache misses
+  // overlap; this pays off on trees much larger than the caches.
+  template <class InputIt, class OutputIt>
+  OutputIt find_many(InputIt first, InputIt last, OutputIt out) {
+    auto probe = [](const auto &key) -> decltype(auto) { return Probe(key); };
+    this->FindMany(first, last, probe, [&](tree_node *node) {
+      *out++ = node ? iterator(node) : this->end();
+    });
+    return out;
+  };
+
+  template <class InputIt, class OutputIt>
+  OutputIt contains_many(InputIt first, InputIt last, OutputIt out) {
+    auto probe = [](const auto &key) -> decltype(auto) { return Probe(key); };
+    this->FindMany(first, last, probe,
+                   [&](tree_node *node) { *out++ = node != nullptr; });
+    return out;
+  };
+
+  template <class K>
+  iterator lower_bound(const K &key) {
+    return iterator(this->LowerBound(Probe(key)));
+  };
+
+  template <class K>
+  iterator upper_bound(const K &key) {
+    return iterator(this->UpperBound(Probe(key)));
+  };
+
+  template <class K>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return this->EqualRange(Probe(key));
+  };
+
+  template <class K>
+  size_type rank(const K &key) {
+    return this->Rank(Probe(key));
+  };
+
+ private:
+  template <class K>
+  static decltype(auto) Probe(const K &key) {
+    return s21::KeyProbe<Key, Compare>(key);
+  };
 };
+
+// Set with subtree sizes: nth, rank and iterator jumps take O(log n).
+template <typename Key, class Compare = s21::SingleComp<Key>>
+using RankedSet = Set<Key, Compare, s21::HeapAllocator, true>;
 }  // namespace s21
 #endif  // S21_CONTAINERS_HEADERS_S21_SET_H_
@@ -0,0 +1,349 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_SKIP_LIST_H_
+#define S21_CONTAINERS_HEADERS_S21_SKIP_LIST_H_
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_epoch.h"
+
+// Lock-free skip list of unique values, after Herlihy and Shavit. A node is
+// erased by marking its links, top level first; the mark on the bottom link
+// decides which eraser wins, and searches unlink marked nodes as they pass.
+// Unlinked nodes go to the epoch domain, so any thread may keep reading
+// them until it unpins. Iterators pin their thread, walk the bottom level
+// and are weakly consistent: they never fail, and see every element present
+// for the whole walk, but may or may not see concurrent changes.
+template <class Value, class Compare>
+class ConcurrentSkipList {
+ public:
+  using value_type = Value;
+  using key_compare = Compare;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+  static constexpr int kMaxLevel = 32;
+
+ protected:
+  using Link = std::atomic<uintptr_t>;
+
+  // Links follow the node in the same allocation, one per level. The low
+  // bit of a link marks the node holding it as erased on that level.
+  struct alignas(Link) Node {
+    value_type data_;
+    int height_;
+    // kLinked once insert stops linking levels, kUnlinked once erase has
+    // marked them all. Whoever sets the second one unlinks the node from
+    // every level, as no more links can appear, and then retires it.
+    std::atomic<int> state_{0};
+
+    template <class... Args>
+    Node(int height, Args &&...args)
+        : data_(std::forward<Args>(args)...), height_(height) {
+      for (int level = 0; level < height; ++level) new (&link(level)) Link(0);
+    };
+
+    Link &link(int level) { return reinterpret_cast<Link *>(this + 1)[level]; };
+
+    template <class... Args>
+    static Node *Create(int height, Args &&...args) {
+      void *memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+      try {
+        return new (memory) Node(height, std::forward<Args>(args)...);
+      } catch (...) {
+        ::operator delete(memory);
+        throw;
+      }
+    };
+
+    static void Destroy(void *memory) {
+      static_cast<Node *>(memory)->~Node();
+      ::operator delete(memory);
+    };
+  };
+
+  static constexpr uintptr_t kMark = 1;
+  static constexpr int kLinked = 1;
+  static constexpr int kUnlinked = 2;
+
+  static Node *Pointer(uintptr_t link) {
+    return reinterpret_cast<Node *>(link & ~kMark);
+  };
+
+  static uintptr_t Word(Node *node) {
+    return reinterpret_cast<uintptr_t>(node);
+  };
+
+  // The first node after node that is not erased.
+  static Node *NextLive(Node *node) {
+    Node *next = Pointer(node->link(0).load());
+    while (next && next->link(0).load() & kMark)
+      next = Pointer(next->link(0).load());
+    return next;
+  };
+
+ public:
+  // Holds a pin on the epoch of the thread that made it, so it must stay on
+  // that thread; the pin is dropped on reaching the end.
+  class Iterator {
+   public:
+    Iterator() : node_(nullptr){};
+    Iterator(Node *node, s21::EpochDomain::Guard guard)
+        : node_(node), guard_(node ? std::move(guard) : Guard()){};
+
+    const_reference operator*() const { return node_->data_; };
+
+    Iterator &operator++() {
+      node_ = NextLive(node_);
+      if (!node_) guard_ = Guard();
+      return *this;
+    };
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    };
+
+    bool operator==(const Iterator &other) const {
+      return node_ == other.node_;
+    };
+
+    bool operator!=(const Iterator &other) const { return !(*this == other); };
+
+    Node *node() const { return node_; };
+
+   private:
+    using Guard = s21::EpochDomain::Guard;
+
+    Node *node_;
+    Guard guard_;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  ConcurrentSkipList() : head_(Node::Create(kMaxLevel)){};
+
+  ConcurrentSkipList(const ConcurrentSkipList &other) = delete;
+  ConcurrentSkipList &operator=(const ConcurrentSkipList &other) = delete;
+
+  // No other thread may use the list any more.
+  ~ConcurrentSkipList() {
+    for (Node *node = head_; node;) {
+      Node *next = Pointer(node->link(0).load());
+      Node::Destroy(node);
+      node = next;
+    }
+  };
+
+  iterator begin() {
+    s21::EpochDomain::Guard guard = Pin();
+    return iterator(NextLive(head_), std::move(guard));
+  };
+
+  iterator end() { return iterator(); };
+
+  const_iterator cbegin() { return begin(); };
+
+  const_iterator cend() { return end(); };
+
+  // Counts finished insertions and erasures, so it is exact only while no
+  // thread changes the list.
+  size_type size() const { return size_.load(); };
+
+  bool empty() const { return !size(); };
+
+  // Erases the elements one by one; elements inserted meanwhile may stay.
+  void clear() {
+    for (iterator it = begin(); it != end(); ++it) Remove(it.node());
+  };
+
+  // Returns the iterator following the erased element.
+  iterator erase(iterator pos) {
+    iterator next = pos;
+    ++next;
+    Remove(pos.node());
+    return next;
+  };
+
+ protected:
+  Node *head_;
+  std::atomic<int> top_{1};
+  std::atomic<size_type> size_{0};
+  key_compare comparator;
+
+  static s21::EpochDomain::Guard Pin() {
+    return s21::EpochDomain::Instance().Pin();
+  };
+
+  template <class L, class R>
+  int Order(const L &a, const R &b) const {
+    return s21::Order(comparator, a, b);
+  };
+
+  // The first live node not less than key. The caller must be pinned.
+  template <class K>
+  Node *LowerBound(const K &key) {
+    Node *pred = head_;
+    Node *curr = nullptr;
+    for (int level = top_.load() - 1; level >= 0; --level) {
+      curr = Pointer(pred->link(level).load());
+      while (curr) {
+        uintptr_t succ = curr->link(level).load();
+        if (succ & kMark) {
+          curr = Pointer(succ);
+        } else if (Order(curr->data_, key) < 0) {
+          pred = curr;
+          curr = Pointer(succ);
+        } else {
+          break;
+        }
+      }
+    }
+    return curr;
+  };
+
+  template <class K>
+  Node *UpperBound(const K &key) {
+    Node *node = LowerBound(key);
+    return node && !Order(key, node->data_) ? NextLive(node) : node;
+  };
+
+  template <class K>
+  Node *Find(const K &key) {
+    Node *node = LowerBound(key);
+    return node && !Order(key, node->data_) ? node : nullptr;
+  };
+
+  // Inserts make() unless an element equal to key is present. make is only
+  // called when the key is missing.
+  template <class K, class Make>
+  std::pair<iterator, bool> InsertUnique(const K &key, Make make) {
+    s21::EpochDomain::Guard guard = Pin();
+    Node *preds[kMaxLevel];
+    Node *succs[kMaxLevel];
+    int height = RandomHeight();
+    for (int top = top_.load(); top < height;)
+      top_.compare_exchange_weak(top, height);
+    Node *node = nullptr;
+    for (;;) {
+      if (Search(key, preds, succs)) {
+        if (node) Node::Destroy(node);
+        return std::pair<iterator, bool>(iterator(succs[0], guard), false);
+      }
+      if (!node) node = Node::Create(height, make());
+      for (int level = 0; level < height; ++level)
+        node->link(level).store(Word(succs[level]));
+      // Counted first, so that a racing erase never takes size below zero.
+      ++size_;
+      uintptr_t expected = Word(succs[0]);
+      if (preds[0]->link(0).compare_exchange_strong(expected, Word(node)))
+        break;
+      --size_;
+    }
+    LinkUpperLevels(key, node, preds, succs);
+    if (node->state_.fetch_or(kLinked) & kUnlinked) {
+      Search(key, preds, succs);
+      s21::EpochDomain::Instance().Retire(node, Node::Destroy);
+    }
+    return std::pair<iterator, bool>(iterator(node, guard), true);
+  };
+
+  // Returns whether this call erased node, rather than another one.
+  bool Remove(Node *node) {
+    s21::EpochDomain::Guard guard = Pin();
+    for (int level = node->height_ - 1; level > 0; --level)
+      node->link(level).fetch_or(kMark);
+    uintptr_t link = node->link(0).load();
+    do {
+      if (link & kMark) return false;
+    } while (!node->link(0).compare_exchange_weak(link, link | kMark));
+    --size_;
+    if (node->state_.fetch_or(kUnlinked) & kLinked) {
+      Node *preds[kMaxLevel];
+      Node *succs[kMaxLevel];
+      Search(node->data_, preds, succs);
+      s21::EpochDomain::Instance().Retire(node, Node::Destroy);
+    }
+    return true;
+  };
+
+ private:
+  // Fills preds and succs with the neighbours of key on every level in use,
+  // unlinking the erased nodes on the way. Returns whether succs[0] equals
+  // key.
+  template <class K>
+  bool Search(const K &key, Node **preds, Node **succs) {
+    while (!TrySearch(key, preds, succs)) {
+    }
+    return succs[0] && !Order(key, succs[0]->data_);
+  };
+
+  // Fails when another thread changed a link this search was unlinking.
+  template <class K>
+  bool TrySearch(const K &key, Node **preds, Node **succs) {
+    Node *pred = head_;
+    for (int level = top_.load() - 1; level >= 0; --level) {
+      Node *curr = Pointer(pred->link(level).load());
+      while (curr) {
+        uintptr_t succ = curr->link(level).load();
+        if (succ & kMark) {
+          uintptr_t expected = Word(curr);
+          if (!pred->link(level).compare_exchange_strong(expected,
+                                                         succ & ~kMark))
+            return false;
+          curr = Pointer(succ);
+        } else if (Order(curr->data_, key) < 0) {
+          pred = curr;
+          curr = Pointer(succ);
+        } else {
+          break;
+        }
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+    return true;
+  };
+
+  // Links node above the bottom level, giving up once it is being erased.
+  template <class K>
+  void LinkUpperLevels(const K &key, Node *node, Node **preds,
+                       Node **succs) {
+    for (int level = 1; level < node->height_; ++level) {
+      for (;;) {
+        uintptr_t link = node->link(level).load();
+        // Only erase changes these links now, so a failure means a mark.
+        if (link & kMark) return;
+        if (Pointer(link) != succs[level] &&
+            !node->link(level).compare_exchange_strong(link,
+                                                       Word(succs[level])))
+          return;
+        uintptr_t expected = Word(succs[level]);
+        if (preds[level]->link(level).compare_exchange_strong(expected,
+                                                              Word(node)))
+          break;
+        if (!Search(key, preds, succs) || succs[0] != node) return;
+      }
+    }
+  };
+
+  // Geometric heights: each level holds about half the nodes of the one
+  // below.
+  static int RandomHeight() {
+    static thread_local uint64_t state =
+        reinterpret_cast<uintptr_t>(&state) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    int height = 1;
+    for (uint64_t bits = state; height < kMaxLevel && bits & 1; bits >>= 1)
+      ++height;
+    return height;
+  };
+};
+
+#endif  // S21_CONTAINERS_HEADERS_S21_SKIP_LIST_H_
@@ -0,0 +1,80 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_UNORDERED_MAP_H_
+#define S21_CONTAINERS_HEADERS_S21_UNORDERED_MAP_H_
+
+#include <initializer_list>
+#include <stdexcept>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+// Map over an open-addressing hash table: the interface of Map without the
+// order, with lookups in expected O(1). Insertions invalidate all
+// iterators and references to elements.
+template <class Key, class T, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class UnorderedMap
+    : public HashTable<Key, std::pair<Key, T>, Hash, KeyEqual> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using table = HashTable<Key, value_type, Hash, KeyEqual>;
+  using iterator = typename table::Iterator;
+  using const_iterator = typename table::ConstIterator;
+  using size_type = size_t;
+
+  UnorderedMap(){};
+
+  UnorderedMap(std::initializer_list<value_type> const &items) {
+    this->reserve(items.size());
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  T &operator[](const Key &key) {
+    iterator it =
+        this->InsertUnique(key, [&] { return value_type(key, T()); }).first;
+    return (*it).second;
+  };
+
+  T &at(const Key &key) {
+    iterator it = this->Find(key);
+    if (it == this->end()) throw std::out_of_range("s21::unordered_map::at");
+    return (*it).second;
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value.first, [&] { return value; });
+  };
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return this->InsertUnique(key, [&] { return value_type(key, obj); });
+  };
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &obj) {
+    std::pair<iterator, bool> answer = insert(key, obj);
+    if (!answer.second) (*answer.first).second = obj;
+    return answer;
+  };
+
+  // Moves the elements whose keys are missing here out of other.
+  void merge(UnorderedMap &other) {
+    for (auto it = other.begin(); it != other.end();) {
+      if (insert(*it).second) {
+        it = other.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  };
+
+  iterator find(const Key &key) { return this->Find(key); };
+
+  bool contains(const Key &key) { return this->Find(key) != this->end(); };
+
+  size_type count(const Key &key) { return contains(key); };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_UNORDERED_MAP_H_
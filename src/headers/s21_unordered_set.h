@@ -0,0 +1,55 @@
+#ifndef S21_CONTAINERS_HEADERS_S21_UNORDERED_SET_H_
+#define S21_CONTAINERS_HEADERS_S21_UNORDERED_SET_H_
+
+#include <initializer_list>
+
+#include "s21_hash_table.h"
+
+namespace s21 {
+// Set over an open-addressing hash table: the interface of Set without the
+// order, with lookups in expected O(1). Insertions invalidate all
+// iterators.
+template <typename Key, class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class UnorderedSet : public HashTable<Key, Key, Hash, KeyEqual> {
+ public:
+  using key_type = Key;
+  using table = HashTable<Key, Key, Hash, KeyEqual>;
+  using value_type = typename table::value_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using iterator = typename table::Iterator;
+  using const_iterator = typename table::ConstIterator;
+
+  UnorderedSet(){};
+
+  UnorderedSet(std::initializer_list<value_type> const &items) {
+    this->reserve(items.size());
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  };
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return this->InsertUnique(value, [&] { return value; });
+  };
+
+  // Moves the elements missing here out of other.
+  void merge(UnorderedSet &other) {
+    for (auto it = other.begin(); it != other.end();) {
+      if (insert(*it).second) {
+        it = other.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  };
+
+  iterator find(const Key &key) { return this->Find(key); };
+
+  bool contains(const Key &key) { return this->Find(key) != this->end(); };
+
+  size_type count(const Key &key) { return contains(key); };
+};
+}  // namespace s21
+
+#endif  // S21_CONTAINERS_HEADERS_S21_UNORDERED_SET_H_
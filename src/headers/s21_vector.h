@@ -1,10 +1,17 @@
 #ifndef S21_CONTAINERS_HEADERS_S21_VECTOR_H_
 #define S21_CONTAINERS_HEADERS_S21_VECTOR_H_
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace s21 {
+// Elements live in raw storage: only the first size_ slots hold
+// constructed elements, so spare capacity costs no constructions and
+// erased elements are destroyed at once.
 template <typename T>
 class Vector {
  public:
@@ -89,32 +96,35 @@ class Vector {
   using size_type = size_t;
   Vector() : size_(0), capacity_(0), arr_(nullptr){};
 
-  Vector(size_type n) : size_(n), capacity_(n) {
-    if (n == 0) {
-      arr_ = nullptr;
-    } else {
-      arr_ = new value_type[n];
-      for (size_type i = 0; i < size_; i++) {
-        arr_[i] = 0;
-      }
+  Vector(size_type n) : size_(0), capacity_(n), arr_(Allocate(n)) {
+    try {
+      for (; size_ < n; size_++) new (arr_ + size_) value_type();
+    } catch (...) {
+      std::destroy(arr_, arr_ + size_);
+      Deallocate(arr_, capacity_);
+      throw;
     }
   };
 
-  Vector(std::initializer_list<value_type> const &items) {
-    size_ = items.size();
-    capacity_ = items.size();
-    arr_ = new value_type[size_];
-    std::copy(items.begin(), items.end(), arr_);
+  Vector(std::initializer_list<value_type> const &items)
+      : size_(items.size()),
+        capacity_(items.size()),
+        arr_(Allocate(items.size())) {
+    try {
+      std::uninitialized_copy(items.begin(), items.end(), arr_);
+    } catch (...) {
+      Deallocate(arr_, capacity_);
+      throw;
+    }
   };
 
   Vector(const Vector &v)
-      : size_(v.size_), capacity_(v.capacity_), arr_(new value_type[size_]) {
-    const_iterator it = v.cbegin();
-    int counter = 0;
-    while (it != v.cend()) {
-      arr_[counter] = *it;
-      ++counter;
-      ++it;
+      : size_(v.size_), capacity_(v.capacity_), arr_(Allocate(capacity_)) {
+    try {
+      std::uninitialized_copy(v.arr_, v.arr_ + v.size_, arr_);
+    } catch (...) {
+      Deallocate(arr_, capacity_);
+      throw;
     }
   };
 
@@ -124,25 +134,16 @@ class Vector {
   };
 
   ~Vector() {
-    size_ = capacity_ = 0;
-    if (arr_ != nullptr) {
-      delete[] arr_;
-      arr_ = nullptr;
-    }
+    clear();
+    Deallocate(arr_, capacity_);
+    capacity_ = 0;
+    arr_ = nullptr;
   };
 
   Vector &operator=(const Vector &v) {
-    size_ = v.size_;
-    capacity_ = v.capacity_;
-    delete[] this->arr_;
-    arr_ = new value_type[capacity_];
-    const_iterator source_it = v.cbegin();
-    iterator dest_it = this->begin();
-    while (source_it != v.cend()) {
-      *dest_it = *source_it;
-      source_it++;
-      dest_it++;
-    }
+    if (this == &v) return *this;
+    Vector copy(v);
+    swap(copy);
     return *this;
   };
 
@@ -176,106 +177,118 @@ class Vector {
 
   iterator end() { return iterator(arr_ + size_); };
 
-  bool empty() { return !(bool)size_; };
+  bool empty() const { return !(bool)size_; };
 
-  size_type size() { return size_; };
+  size_type size() const { return size_; };
 
   size_type max_size() const {
     return std::numeric_limits<size_type>::max() / (2 * sizeof(value_type));
   };
 
   void reserve(size_type size) {
-    if (size > capacity_) {
-      int counter = 0;
-      capacity_ = size;
-      value_type *tmp = new value_type[capacity_];
-      Vector<value_type>::iterator it = this->begin();
-      while (it != this->end()) {
-        tmp[counter] = *it;
-        counter++;
-        it++;
-      }
-      delete[] arr_;
-      arr_ = tmp;
-    }
+    if (size > capacity_) Reallocate(size);
   };
 
   size_type capacity() { return capacity_; };
 
   void shrink_to_fit() {
-    int counter = 0;
-    capacity_ = this->size();
-    value_type *tmp = new value_type[capacity_];
-    iterator it = this->begin();
-    while (it != this->end()) {
-      tmp[counter] = *it;
-      counter++;
-      it++;
-    }
-    delete[] arr_;
-    arr_ = tmp;
+    if (size_ < capacity_) Reallocate(size_);
   };
 
   void clear() {
-    for (size_type i = 0; i < size_; i++) {
-      arr_[i] = '\0';
-    }
+    std::destroy(arr_, arr_ + size_);
     size_ = 0;
   };
 
   iterator insert(iterator pos, const_reference value) {
-    int counter = 0;
-    for (iterator it = this->end(); it != pos; it--) {
-      counter++;
-    }
-    if (size_ == capacity_) {
-      this->reserve(this->size_ * 2);
+    // value may be an element of this vector, which the shift moves.
+    if (&value >= arr_ && &value < arr_ + size_) {
+      value_type copy(value);
+      return insert(pos, std::move(copy));
     }
-    iterator it = this->end();
-    iterator it_2 = it - 1;
-    for (int i = 0; i != counter; i++) {
-      *it = *it_2;
-      it--;
-      it_2--;
-    }
-    *it = value;
-    iterator returnable = it;
-    size_++;
-    return returnable;
+    return Emplace(&*pos - arr_, value);
   };
 
+  iterator insert(iterator pos, value_type &&value) {
+    return Emplace(&*pos - arr_, std::move(value));
+  };
+
+  // The elements after pos are moved down, and the last slot destroyed.
   void erase(iterator pos) {
-    iterator it = pos;
-    iterator it_2 = pos + 1;
-    while (it_2 != this->end()) {
-      *it = *it_2;
-      it++;
-      it_2++;
+    value_type *slot = &*pos;
+    std::move(slot + 1, arr_ + size_, slot);
+    arr_[--size_].~value_type();
+  };
+
+  void push_back(const_reference value) {
+    if (size_ < capacity_) {
+      new (arr_ + size_) value_type(value);
+      size_++;
+    } else {
+      this->insert(this->end(), value);
     }
-    *it = '\0';
-    size_--;
   };
 
-  void push_back(const_reference value) { this->insert(this->end(), value); };
+  void push_back(value_type &&value) {
+    if (size_ == capacity_) Reallocate(size_ ? size_ * 2 : 1);
+    new (arr_ + size_) value_type(std::move(value));
+    size_++;
+  };
 
   void pop_back() { this->erase(this->end() - 1); };
 
   void swap(Vector &other) {
-    value_type *tmp = other.data();
+    std::swap(arr_, other.arr_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  };
 
-    int size = other.size();
-    int capacity = other.capacity();
+ private:
+  static value_type *Allocate(size_type n) {
+    return n ? std::allocator<value_type>().allocate(n) : nullptr;
+  };
 
-    other.arr_ = this->data();
-    other.size_ = this->size();
-    other.capacity_ = this->capacity();
+  static void Deallocate(value_type *array, size_type n) {
+    if (array) std::allocator<value_type>().deallocate(array, n);
+  };
 
-    this->arr_ = tmp;
-    this->size_ = size;
-    this->capacity_ = capacity;
+  // Moves the elements into new storage of the given capacity. They are
+  // copied instead when a throwing move could lose some of them.
+  void Reallocate(size_type capacity) {
+    value_type *array = Allocate(capacity);
+    try {
+      if constexpr (std::is_nothrow_move_constructible<value_type>::value ||
+                    !std::is_copy_constructible<value_type>::value) {
+        std::uninitialized_move(arr_, arr_ + size_, array);
+      } else {
+        std::uninitialized_copy(arr_, arr_ + size_, array);
+      }
+    } catch (...) {
+      Deallocate(array, capacity);
+      throw;
+    }
+    std::destroy(arr_, arr_ + size_);
+    Deallocate(arr_, capacity_);
+    arr_ = array;
+    capacity_ = capacity;
+  };
+
+  // Constructs the new element at index, moving the later ones one slot up.
+  template <class Arg>
+  iterator Emplace(size_type index, Arg &&value) {
+    if (size_ == capacity_) Reallocate(size_ ? size_ * 2 : 1);
+    value_type *slot = arr_ + index;
+    if (index == size_) {
+      new (slot) value_type(std::forward<Arg>(value));
+    } else {
+      new (arr_ + size_) value_type(std::move(arr_[size_ - 1]));
+      std::move_backward(slot, arr_ + size_ - 1, arr_ + size_);
+      *slot = std::forward<Arg>(value);
+    }
+    size_++;
+    return iterator(slot);
   };
 
- private:
   size_type size_, capacity_;
   value_type *arr_;
 };
@@ -1,12 +1,145 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdlib>
 #include <list>
+#include <map>
+#include <new>
 #include <queue>
+#include <set>
+#include <sstream>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "headers/s21_containers.h"
+#include "headers/s21_containersplus.h"
+
+// Counts heap allocations made through operator new, from any thread. Every
+// replaceable form is replaced so that each delete meets its own new. The
+// malloc and free calls stay out of line: inlined into a delete expression,
+// free() on a pointer from operator new trips -Wmismatched-new-delete.
+static std::atomic<size_t> allocation_count{0};
+
+// Allocations to let through before one fails, or -1 for none to fail.
+static std::atomic<int> allocations_before_failure{-1};
+
+static bool FailAllocation() {
+  int left = allocations_before_failure.load();
+  while (left >= 0 &&
+         !allocations_before_failure.compare_exchange_weak(left, left - 1)) {
+  }
+  return left == 0;
+}
+
+#ifdef __GNUC__
+#define S21_TEST_NOINLINE __attribute__((noinline))
+#else
+#define S21_TEST_NOINLINE
+#endif
+
+S21_TEST_NOINLINE static void *CountedAllocate(size_t size) {
+  ++allocation_count;
+  if (FailAllocation()) return nullptr;
+  return std::malloc(size ? size : 1);
+}
+
+S21_TEST_NOINLINE static void *CountedAllocate(size_t size,
+                                               std::align_val_t align) {
+  ++allocation_count;
+  if (FailAllocation()) return nullptr;
+  size_t alignment = static_cast<size_t>(align);
+  if (alignment < sizeof(void *)) alignment = sizeof(void *);
+  void *memory = nullptr;
+  if (posix_memalign(&memory, alignment, size ? size : 1)) return nullptr;
+  return memory;
+}
+
+S21_TEST_NOINLINE static void CountedFree(void *memory) { std::free(memory); }
+
+void *operator new(size_t size) {
+  if (void *memory = CountedAllocate(size)) return memory;
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+  if (void *memory = CountedAllocate(size)) return memory;
+  throw std::bad_alloc();
+}
+
+void *operator new(size_t size, std::align_val_t align) {
+  if (void *memory = CountedAllocate(size, align)) return memory;
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t align) {
+  if (void *memory = CountedAllocate(size, align)) return memory;
+  throw std::bad_alloc();
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size);
+}
+
+void *operator new(size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept {
+  return CountedAllocate(size, align);
+}
+
+void *operator new[](size_t size, std::align_val_t align,
+                     const std::nothrow_t &) noexcept {
+  return CountedAllocate(size, align);
+}
+
+void operator delete(void *memory) noexcept { CountedFree(memory); }
+
+void operator delete[](void *memory) noexcept { CountedFree(memory); }
+
+void operator delete(void *memory, size_t) noexcept { CountedFree(memory); }
+
+void operator delete[](void *memory, size_t) noexcept { CountedFree(memory); }
+
+void operator delete(void *memory, std::align_val_t) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete[](void *memory, size_t, std::align_val_t) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete(void *memory, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  CountedFree(memory);
+}
+
+void operator delete[](void *memory, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  CountedFree(memory);
+}
 
 // S21_MAP
 TEST(MapTest, MapBaseConstruct) {
@@ -210,6 +343,283 @@ TEST(MapTest, MapIter) {
   }
 }
 
+TEST(MapTest, MapAtMissing) {
+  s21::Map<int, int> map({std::pair<int, int>(1, 4)});
+  ASSERT_THROW(map.at(2), std::out_of_range);
+  ASSERT_EQ(map.size(), 1);
+}
+
+TEST(MapTest, MapBr3) {
+  s21::Map<std::string, std::string> map;
+  map["b"] = "two";
+  map["a"] = "one";
+  map["b"] += "!";
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map.at("b"), "two!");
+  ASSERT_EQ((*map.begin()).first, "a");
+}
+
+TEST(MapTest, MapLargeLookup) {
+  s21::Map<int, int> map;
+  for (int i = 0; i < 100000; ++i) map[i] = i * 2;
+  ASSERT_EQ(map.size(), 100000);
+  for (int i = 0; i < 100000; i += 7) {
+    ASSERT_TRUE(map.contains(i));
+    ASSERT_EQ(map.at(i), i * 2);
+    ASSERT_EQ(map[i], i * 2);
+  }
+  ASSERT_FALSE(map.contains(-1));
+  ASSERT_FALSE(map.contains(100000));
+  ASSERT_EQ(map.size(), 100000);
+}
+
+TEST(MapTest, MapFind) {
+  s21::Map<int, int> map({std::pair<int, int>(1, 4), std::pair<int, int>(3, 5),
+                          std::pair<int, int>(5, 7)});
+  ASSERT_EQ((*map.find(3)).second, 5);
+  ASSERT_TRUE(map.find(4) == map.end());
+}
+
+TEST(MapTest, MapBounds) {
+  s21::Map<int, int> map({std::pair<int, int>(1, 4), std::pair<int, int>(3, 5),
+                          std::pair<int, int>(5, 7)});
+  ASSERT_EQ((*map.lower_bound(3)).first, 3);
+  ASSERT_EQ((*map.lower_bound(4)).first, 5);
+  ASSERT_EQ((*map.upper_bound(3)).first, 5);
+  ASSERT_EQ((*map.lower_bound(0)).first, 1);
+  ASSERT_TRUE(map.lower_bound(6) == map.end());
+  ASSERT_TRUE(map.upper_bound(5) == map.end());
+  auto range = map.equal_range(3);
+  ASSERT_EQ((*range.first).first, 3);
+  ASSERT_EQ((*range.second).first, 5);
+}
+
+TEST(MapTest, MapPoolAllocator) {
+  s21::Map<int, std::string, s21::PairComp<int, std::string>,
+           s21::PoolAllocator>
+      map;
+  for (int i = 0; i < 100; ++i) map[i] = std::string(i, 'x');
+  s21::Map<int, std::string, s21::PairComp<int, std::string>,
+           s21::PoolAllocator>
+      other(std::move(map));
+  other.erase(other.find(50));
+  ASSERT_EQ(other.size(), 99);
+  ASSERT_EQ(other.at(99), std::string(99, 'x'));
+  ASSERT_FALSE(other.contains(50));
+  ASSERT_EQ(map.size(), 0);
+}
+
+TEST(MapTest, MapNodeHandles) {
+  s21::Map<int, std::string> map, other;
+  for (int i = 0; i < 100; ++i) map[i] = std::string(i, 'x');
+  size_t before = allocation_count;
+  for (int i = 0; i < 100; i += 2) {
+    s21::Map<int, std::string>::node_type node = map.extract(i);
+    node.key() += 1000;
+    ASSERT_TRUE(map.insert(std::move(node)).inserted);
+  }
+  s21::Map<int, std::string>::node_type node = map.extract(map.find(1));
+  const std::string *mapped = &node.mapped();
+  auto result = other.insert(std::move(node));
+  ASSERT_EQ(allocation_count - before, 0);
+  ASSERT_TRUE(result.inserted);
+  ASSERT_TRUE(node.empty());
+  ASSERT_EQ(&(*result.position).second, mapped);
+  ASSERT_EQ(map.size(), 99);
+  ASSERT_EQ(map.at(1098), std::string(98, 'x'));
+  ASSERT_FALSE(map.contains(98));
+  ASSERT_TRUE(map.extract(98).empty());
+  other[3] = "y";
+  result = other.insert(map.extract(3));
+  ASSERT_FALSE(result.inserted);
+  ASSERT_EQ(result.node.mapped(), "xxx");
+  ASSERT_EQ((*result.position).second, "y");
+  ASSERT_EQ(map.size(), 98);
+}
+
+TEST(MapTest, MapInPlaceInsertion) {
+  using Payload = std::vector<char>;
+  s21::Map<std::string, Payload> map;
+  std::string key(100, 'k');
+  Payload payload(1000, 'p');
+  const char *data = payload.data();
+  size_t before = allocation_count;
+  ASSERT_TRUE(map.insert({std::move(key), std::move(payload)}).second);
+  ASSERT_EQ(allocation_count - before, 1);
+  ASSERT_EQ((*map.begin()).second.data(), data);
+  payload.assign(1000, 'q');
+  data = payload.data();
+  before = allocation_count;
+  auto result = map.emplace(std::string(2, 'e'), std::move(payload));
+  ASSERT_EQ(allocation_count - before, 1);
+  ASSERT_EQ((*result.first).second.data(), data);
+  payload.assign(1000, 'r');
+  before = allocation_count;
+  ASSERT_FALSE(map.try_emplace("ee", std::move(payload)).second);
+  ASSERT_EQ(allocation_count - before, 0);
+  ASSERT_EQ(payload.size(), 1000);
+  data = payload.data();
+  ASSERT_TRUE(map.try_emplace("t", std::move(payload)).second);
+  ASSERT_EQ(map.at("t").data(), data);
+  before = allocation_count;
+  ASSERT_TRUE(map.try_emplace("u", 10, 'u').second);
+  ASSERT_EQ(allocation_count - before, 2);
+  payload.assign(1000, 's');
+  data = payload.data();
+  before = allocation_count;
+  ASSERT_FALSE(map.insert_or_assign("u", std::move(payload)).second);
+  ASSERT_EQ(allocation_count - before, 0);
+  ASSERT_EQ(map.at("u").data(), data);
+  ASSERT_EQ(map.size(), 4);
+  ASSERT_EQ(map.at("ee")[0], 'q');
+}
+
+TEST(MapTest, MapInsertMany) {
+  s21::Map<int, std::string> map = {{2, "two"}};
+  using item = std::pair<int, std::string>;
+  auto results = map.insert_many(item(3, "three"), item(2, "deux"),
+                                 item(1, "one"), item(3, "trois"));
+  ASSERT_TRUE(results[0].second && results[2].second);
+  ASSERT_FALSE(results[1].second || results[3].second);
+  ASSERT_EQ((*results[3].first).second, "three");
+  ASSERT_EQ(map.at(2), "two");
+  std::vector<item> items = {{0, "zero"}, {4, "four"}};
+  map.insert_range(items.begin(), items.end());
+  ASSERT_EQ(map.size(), 5);
+  int key = 0;
+  for (auto entry : map) ASSERT_EQ(entry.first, key++);
+}
+
+TEST(MapTest, MapFindMany) {
+  s21::Map<std::string, int> map = {{"a", 1}, {"c", 3}, {"e", 5}};
+  const char *keys[] = {"e", "b", "a", "f"};
+  bool present[4];
+  map.contains_many(keys, keys + 4, present);
+  ASSERT_TRUE(present[0] && present[2]);
+  ASSERT_FALSE(present[1] || present[3]);
+  s21::Map<std::string, int>::iterator found[4];
+  map.find_many(keys, keys + 4, found);
+  ASSERT_EQ((*found[0]).second, 5);
+  ASSERT_TRUE(found[1] == map.end());
+}
+
+// A mapped type counting its default constructions, which lookups through a
+// non-transparent comparator make for every probe pair they build.
+struct DefaultCounted {
+  DefaultCounted() { ++made; };
+  DefaultCounted(int number) : number(number){};
+
+  static int made;
+  int number = 0;
+};
+
+int DefaultCounted::made = 0;
+
+// Compares whole pairs only.
+struct PairOnlyComp {
+  using pair = std::pair<const int, DefaultCounted>;
+
+  bool LessThan(const pair &a, const pair &b) const {
+    return a.first < b.first;
+  };
+  bool GreaterThan(const pair &a, const pair &b) const {
+    return a.first > b.first;
+  };
+};
+
+// Orders keys, and pairs by their keys, without being transparent.
+struct KeyOrder {
+  using pair = std::pair<std::string, DefaultCounted>;
+
+  int Compare(const pair &a, const pair &b) const {
+    return a.first.compare(b.first);
+  };
+  int Compare(const std::string &a, const std::string &b) const {
+    return a.compare(b);
+  };
+};
+
+TEST(MapTest, MapTryEmplaceBuildsNothing) {
+  s21::Map<std::string, DefaultCounted, KeyOrder> map;
+  std::string key(100, 'k');
+  ASSERT_TRUE(map.try_emplace(key, 1).second);
+  ASSERT_TRUE(map.try_emplace(std::string(100, 'j'), 2).second);
+  DefaultCounted::made = 0;
+  size_t before = allocation_count;
+  ASSERT_FALSE(map.try_emplace(key, 3).second);
+  ASSERT_FALSE(map.insert_or_assign(key, DefaultCounted(4)).second);
+  ASSERT_EQ(allocation_count - before, 0);
+  ASSERT_EQ(DefaultCounted::made, 0);
+  ASSERT_EQ(map.at(key).number, 4);
+  ASSERT_EQ((*map.begin()).second.number, 2);
+}
+
+TEST(MapTest, MapFindManyProbesOnce) {
+  s21::Map<int, DefaultCounted, PairOnlyComp> map;
+  for (int i = 0; i < 1000; i += 2) map.insert(i, DefaultCounted(i));
+  std::stringstream keys;
+  for (int i = 0; i < 100; ++i) keys << i * 7 << ' ';
+  bool present[100];
+  DefaultCounted::made = 0;
+  map.contains_many(std::istream_iterator<int>(keys),
+                    std::istream_iterator<int>(), present);
+  ASSERT_EQ(DefaultCounted::made, 100);
+  for (int i = 0; i < 100; ++i) ASSERT_EQ(present[i], i % 2 == 0);
+}
+
+TEST(MapTest, MapRanked) {
+  s21::RankedMap<int, int> map;
+  for (int i = 100; i > 0; --i) map[i * 10] = i;
+  ASSERT_EQ((*map.nth(0)).first, 10);
+  ASSERT_EQ((*map.nth(99)).second, 100);
+  ASSERT_EQ(map.rank(55), 5);
+  ASSERT_EQ((*(map.begin() + 42)).first, 430);
+}
+
+TEST(MapTest, MapFromSorted) {
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 100; ++i) items.push_back({i, -i});
+  auto map = s21::Map<int, int>::from_sorted(items.begin(), items.end());
+  ASSERT_EQ(map.size(), 100);
+  ASSERT_EQ(map.at(42), -42);
+  s21::Map<int, int> other(s21::assume_sorted, {{1, 1}, {2, 2}});
+  other = map;
+  ASSERT_EQ(other.size(), 100);
+  ASSERT_FALSE(other.contains(100));
+  s21::Map<int, int> &alias = other;
+  other = alias;
+  ASSERT_EQ(other.size(), 100);
+}
+
+TEST(MapTest, MapTransparentLookup) {
+  s21::Map<std::string, int> map;
+  for (int i = 0; i < 100; ++i)
+    map["a key long enough to be allocated " + std::to_string(i)] = i;
+  std::string key = "a key long enough to be allocated 42";
+  std::string_view probe = key;
+  size_t before = allocation_count;
+  auto found = map.find(probe);
+  bool contains = map.contains(probe);
+  size_t count = map.count(probe);
+  int value = map.at(probe);
+  auto lower = map.lower_bound(probe);
+  auto upper = map.upper_bound(probe);
+  auto range = map.equal_range(probe);
+  bool literal = map.contains("a key long enough to be allocated 7");
+  bool missing = map.contains("a key long enough to be allocated 100");
+  size_t allocations = allocation_count - before;
+  ASSERT_EQ(allocations, 0);
+  ASSERT_EQ((*found).second, 42);
+  ASSERT_TRUE(contains);
+  ASSERT_EQ(count, 1);
+  ASSERT_EQ(value, 42);
+  ASSERT_TRUE(lower == found);
+  ASSERT_EQ((*upper).second, 43);
+  ASSERT_TRUE(range.first == lower && range.second == upper);
+  ASSERT_TRUE(literal);
+  ASSERT_FALSE(missing);
+}
+
 // S21_SET
 TEST(SetTest, SetBaseConstruct) {
   std::cout << "\n ============== TEST: S21_SET ============== \n" << std::endl;
@@ -333,6 +743,23 @@ TEST(SetTest, SetErase1) {
   ASSERT_EQ(set.size(), 2);
 }
 
+TEST(SetTest, SetErase2) {
+  s21::Set<int> set;
+  for (int i = 0; i < 100; ++i) set.insert(i);
+  for (auto it = set.begin(); it != set.end();)
+    it = *it % 2 ? set.erase(it) : it + 1;
+  ASSERT_EQ(set.size(), 50);
+  auto last = set.erase(set.find(20), set.find(80));
+  ASSERT_EQ(*last, 80);
+  ASSERT_EQ(set.size(), 20);
+  ASSERT_EQ(*--last, 18);
+  ASSERT_TRUE(set.erase(set.end()) == set.end());
+  set.erase(set.begin(), set.end());
+  ASSERT_EQ(set.size(), 0);
+  set.insert(1);
+  ASSERT_EQ(*set.begin(), 1);
+}
+
 TEST(SetTest, SetSwap) {
   s21::Set<int> set({1, 2, 3});
   s21::Set<int> set1({4, 5, 6, 7});
@@ -381,6 +808,1648 @@ TEST(SetTest, SetIter) {
   }
 }
 
+TEST(SetTest, SetFindMissing) {
+  s21::Set<int> set({1, 3, 5});
+  ASSERT_TRUE(set.find(2) == set.end());
+  ASSERT_TRUE(set.find(6) == set.end());
+  s21::Set<int> empty;
+  ASSERT_TRUE(empty.find(1) == empty.end());
+}
+
+TEST(SetTest, SetBounds) {
+  s21::Set<int> set;
+  for (int i = 0; i < 1000; i += 2) set.insert(i);
+  for (int i = -1; i < 998; ++i) {
+    ASSERT_EQ(*set.lower_bound(i), i + (i % 2 != 0));
+    ASSERT_EQ(*set.upper_bound(i), i % 2 ? i + 1 : i + 2);
+  }
+  ASSERT_TRUE(set.lower_bound(999) == set.end());
+  ASSERT_TRUE(set.upper_bound(998) == set.end());
+  auto hit = set.equal_range(10);
+  ASSERT_EQ(*hit.first, 10);
+  ASSERT_EQ(*hit.second, 12);
+  auto miss = set.equal_range(11);
+  ASSERT_TRUE(miss.first == miss.second);
+  ASSERT_EQ(*miss.first, 12);
+}
+
+TEST(SetTest, SetPoolAllocator) {
+  s21::Set<int, s21::SingleComp<int>, s21::PoolAllocator> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  for (auto it = set.begin(); it != set.end();) {
+    auto next = it + 1;
+    if (*it % 2) set.erase(it);
+    it = next;
+  }
+  for (int i = 1000; i < 1500; ++i) set.insert(i);
+  ASSERT_EQ(set.size(), 1000);
+  s21::Set<int, s21::SingleComp<int>, s21::PoolAllocator> other({1, 2, 3});
+  set.merge(other);
+  ASSERT_EQ(set.size(), 1002);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_TRUE(set.contains(3));
+  set.swap(other);
+  ASSERT_EQ(set.size(), 1);
+  ASSERT_EQ(*set.begin(), 2);
+  other.clear();
+  other.insert(5);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(*other.begin(), 5);
+}
+
+TEST(SetTest, SetIterEmpty) {
+  s21::Set<int> set;
+  ASSERT_TRUE(set.begin() == set.end());
+  for (auto it : set) FAIL() << it;
+  set.insert(1);
+  set.erase(set.begin());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(SetTest, SetIterBothWays) {
+  s21::Set<int> set;
+  for (int i = 0; i < 500; ++i) set.insert(i * 37 % 500);
+  ASSERT_EQ(sizeof(s21::Set<int>::iterator), sizeof(void *));
+  int expected = 0;
+  for (auto it = set.begin(); it != set.end(); ++it) ASSERT_EQ(*it, expected++);
+  for (auto it = set.end(); it != set.begin();) ASSERT_EQ(*--it, --expected);
+  ASSERT_EQ(expected, 0);
+}
+
+TEST(SetTest, SetRanked) {
+  s21::RankedSet<int> set;
+  for (int i = 0; i < 2000; ++i) set.insert(i * 7 % 2000 * 2);
+  for (auto it = set.begin(); it != set.end();) {
+    auto next = it + 1;
+    if (*it % 3 == 0) set.erase(it);
+    it = next;
+  }
+  std::vector<int> expected;
+  for (int i = 0; i < 4000; i += 2)
+    if (i % 3) expected.push_back(i);
+  ASSERT_EQ(set.size(), expected.size());
+  for (size_t k = 0; k < expected.size(); ++k) {
+    ASSERT_EQ(*set.nth(k), expected[k]);
+    ASSERT_EQ(set.rank(expected[k]), k);
+    ASSERT_EQ(set.rank(expected[k] + 1), k + 1);
+  }
+  ASSERT_TRUE(set.nth(expected.size()) == set.end());
+  ASSERT_EQ(*(set.begin() + 100), expected[100]);
+  ASSERT_EQ(*(set.end() - 1), expected.back());
+  ASSERT_TRUE(set.begin() + expected.size() == set.end());
+  auto it = set.nth(500);
+  it -= 250;
+  ASSERT_EQ(*it, expected[250]);
+  it += 1000;
+  ASSERT_EQ(*it, expected[1250]);
+}
+
+struct Tracked {
+  static int alive;
+  int value;
+  Tracked(int v = 0) : value(v) { ++alive; }
+  Tracked(const Tracked &other) : value(other.value) { ++alive; }
+  Tracked &operator=(const Tracked &other) = default;
+  ~Tracked() { --alive; }
+  bool operator<(const Tracked &other) const { return value < other.value; }
+  bool operator>(const Tracked &other) const { return value > other.value; }
+  bool operator<=(const Tracked &other) const { return value <= other.value; }
+  bool operator>=(const Tracked &other) const { return value >= other.value; }
+  bool operator==(const Tracked &other) const { return value == other.value; }
+  bool operator!=(const Tracked &other) const { return value != other.value; }
+};
+
+int Tracked::alive = 0;
+
+TEST(SetTest, SetClearDestroysAll) {
+  int before = Tracked::alive;
+  {
+    s21::Set<Tracked> set;
+    for (int i = 0; i < 1000; ++i) set.insert(i * 13 % 1000);
+    s21::Set<Tracked, s21::SingleComp<Tracked>, s21::PoolAllocator> pooled;
+    for (int i = 0; i < 1000; ++i) pooled.insert(i);
+    set.clear();
+    pooled.clear();
+    ASSERT_EQ(Tracked::alive, before + 4);
+    ASSERT_TRUE(set.begin() == set.end());
+    set.insert(5);
+    pooled.insert(7);
+    ASSERT_EQ((*set.begin()).value, 5);
+    ASSERT_EQ((*pooled.begin()).value, 7);
+    for (int i = 0; i < 1000; ++i) pooled.insert(i);
+  }
+  ASSERT_EQ(Tracked::alive, before);
+}
+
+TEST(SetTest, SetTransparentLookup) {
+  s21::Set<std::string> set({"alpha", "beta", "gamma"});
+  std::string_view probe = "beta";
+  ASSERT_EQ(*set.find(probe), "beta");
+  ASSERT_EQ(set.count("gamma"), 1);
+  ASSERT_EQ(set.count("delta"), 0);
+  ASSERT_EQ(*set.lower_bound("b"), "beta");
+  s21::Set<int> numbers({1, 2, 3});
+  ASSERT_TRUE(numbers.contains(2u));
+  ASSERT_EQ(*numbers.lower_bound(2.5), 2);
+}
+
+// Six-predicate comparator without Compare, ordering ints from high to low.
+struct ReverseComp {
+  bool LessThan(const int &a, const int &b) const { return a > b; }
+  bool GreaterThan(const int &a, const int &b) const { return a < b; }
+  bool LessOrEquals(const int &a, const int &b) const { return a >= b; }
+  bool GreaterOrEquals(const int &a, const int &b) const { return a <= b; }
+  bool Equals(const int &a, const int &b) const { return a == b; }
+  bool NotEquals(const int &a, const int &b) const { return a != b; }
+};
+
+// Three-way comparator that counts its calls.
+struct CountingComp {
+  static int calls;
+  int Compare(const int &a, const int &b) const {
+    ++calls;
+    return a < b ? -1 : a > b;
+  }
+  bool LessThan(const int &a, const int &b) const {
+    ++calls;
+    return a < b;
+  }
+  bool GreaterThan(const int &a, const int &b) const {
+    ++calls;
+    return a > b;
+  }
+};
+
+int CountingComp::calls = 0;
+
+TEST(SetTest, SetLegacyComparator) {
+  s21::Set<int, ReverseComp> set({3, 1, 4, 1, 5, 9, 2, 6});
+  int expected[] = {9, 6, 5, 4, 3, 2, 1};
+  int i = 0;
+  for (auto it : set) ASSERT_EQ(it, expected[i++]);
+  ASSERT_EQ(i, 7);
+  ASSERT_EQ(*set.find(4), 4);
+  ASSERT_EQ(*set.lower_bound(7), 6);
+  set.erase(set.find(5));
+  ASSERT_FALSE(set.contains(5));
+}
+
+TEST(SetTest, SetThreeWayComparator) {
+  s21::Set<int, CountingComp> set;
+  for (int i = 0; i < 1023; ++i) set.insert(i);
+  CountingComp::calls = 0;
+  for (int i = 0; i < 1023; ++i) ASSERT_EQ(*set.find(i), i);
+  ASSERT_LE(CountingComp::calls, 1023 * 2 * 10);
+  CountingComp::calls = 0;
+  set.find(-1);
+  ASSERT_LE(CountingComp::calls, 2 * 10);
+}
+
+template <class Key>
+class SetInspector : public s21::Set<Key> {
+ public:
+  using tree_node = typename s21::Set<Key>::tree_node;
+
+  int Height() { return Height(this->root_); }
+
+  // Returns the black height of the tree, or -1 if a red-black rule is broken.
+  int BlackHeight() { return BlackHeight(this->root_); }
+
+ private:
+  bool IsNil(tree_node *node) {
+    return !node || node == this->begin_nil_ || node == this->end_nil_;
+  }
+
+  int Height(tree_node *node) {
+    if (IsNil(node)) return 0;
+    return 1 + std::max(Height(node->left_), Height(node->right_));
+  }
+
+  int BlackHeight(tree_node *node) {
+    if (IsNil(node)) return 0;
+    if (node->red_ && ((!IsNil(node->left_) && node->left_->red_) ||
+                       (!IsNil(node->right_) && node->right_->red_)))
+      return -1;
+    int left = BlackHeight(node->left_);
+    int right = BlackHeight(node->right_);
+    if (left < 0 || left != right) return -1;
+    return left + !node->red_;
+  }
+};
+
+TEST(SetTest, SetFromSorted) {
+  for (int n = 0; n < 70; ++n) {
+    std::vector<int> keys;
+    for (int i = 0; i < n; ++i) keys.push_back(i * 3);
+    SetInspector<int> set;
+    static_cast<s21::Set<int> &>(set) =
+        s21::Set<int>::from_sorted(keys.begin(), keys.end());
+    ASSERT_EQ(set.size(), static_cast<size_t>(n));
+    ASSERT_GE(set.BlackHeight(), 0);
+    int i = 0;
+    for (auto it : set) ASSERT_EQ(it, keys[i++]);
+    ASSERT_EQ(i, n);
+    set.insert(-1);
+    set.insert(n * 3);
+    set.erase(set.begin());
+    ASSERT_GE(set.BlackHeight(), 0);
+    ASSERT_EQ(set.size(), static_cast<size_t>(n + 1));
+  }
+}
+
+TEST(SetTest, SetCopyShape) {
+  SetInspector<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i * 7 % 1000);
+  SetInspector<int> copy;
+  static_cast<s21::Set<int> &>(copy) = set;
+  ASSERT_EQ(copy.Height(), set.Height());
+  ASSERT_EQ(copy.BlackHeight(), set.BlackHeight());
+  copy.erase(copy.find(10));
+  ASSERT_TRUE(set.contains(10));
+  ASSERT_FALSE(copy.contains(10));
+  int i = 0;
+  for (auto it : copy) ASSERT_EQ(it, i < 10 ? i++ : ++i);
+  s21::RankedSet<int> ranked(s21::assume_sorted, {1, 2, 3, 4, 5});
+  s21::RankedSet<int> ranked_copy(ranked);
+  ASSERT_EQ(*ranked_copy.nth(3), 4);
+}
+
+TEST(SetTest, SetBalancedSorted) {
+  SetInspector<int> set;
+  for (int i = 0; i < 10000; ++i) set.insert(i);
+  ASSERT_EQ(set.size(), 10000);
+  ASSERT_GT(set.BlackHeight(), 0);
+  ASSERT_LE(set.Height(), 2 * 14);
+  int i = 0;
+  for (auto it : set) ASSERT_EQ(it, i++);
+}
+
+TEST(SetTest, SetBalancedErase) {
+  SetInspector<int> set;
+  for (int i = 10000; i > 0; --i) set.insert(i * 7 % 10007);
+  for (auto it = set.begin(); it != set.end();) {
+    auto next = it + 1;
+    if (*it % 3) set.erase(it);
+    it = next;
+  }
+  ASSERT_GT(set.BlackHeight(), 0);
+  ASSERT_LE(set.Height(), 2 * 12);
+  int prev = -1;
+  for (auto it : set) {
+    ASSERT_EQ(it % 3, 0);
+    ASSERT_LT(prev, it);
+    prev = it;
+  }
+  ASSERT_EQ(*set.begin(), 3);
+  ASSERT_EQ(*(--set.end()), prev);
+  set.clear();
+  ASSERT_EQ(set.size(), 0);
+}
+
+TEST(SetTest, SetAlgebra) {
+  std::srand(5);
+  for (int round = 0; round < 20; ++round) {
+    std::set<int> a, b;
+    for (int i = 0; i < round * 50; ++i) a.insert(std::rand() % 1000);
+    for (int i = 0; i < 600; ++i) b.insert(std::rand() % 1000);
+    SetInspector<int> other;
+    for (int key : b) other.insert(key);
+    for (int operation = 0; operation < 4; ++operation) {
+      SetInspector<int> set;
+      for (int key : a) set.insert(key);
+      std::vector<int> expected;
+      auto out = std::back_inserter(expected);
+      if (operation == 0) {
+        set.set_union(other);
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), out);
+      } else if (operation == 1) {
+        set.set_intersection(other);
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out);
+      } else if (operation == 2) {
+        set.set_difference(other);
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out);
+      } else {
+        set.set_symmetric_difference(other);
+        std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                      out);
+      }
+      ASSERT_EQ(set.size(), expected.size());
+      ASSERT_GE(set.BlackHeight(), 0);
+      size_t i = 0;
+      for (int key : set) ASSERT_EQ(key, expected[i++]);
+      ASSERT_EQ(other.size(), b.size());
+    }
+  }
+}
+
+TEST(SetTest, SetAlgebraWithItself) {
+  for (int operation = 0; operation < 4; ++operation) {
+    SetInspector<int> set;
+    for (int i = 0; i < 100; ++i) set.insert(i * 7 % 100);
+    if (operation == 0) {
+      set.set_union(set);
+    } else if (operation == 1) {
+      set.set_intersection(set);
+    } else if (operation == 2) {
+      set.set_difference(set);
+    } else {
+      set.set_symmetric_difference(set);
+    }
+    ASSERT_EQ(set.size(), operation < 2 ? 100 : 0);
+    ASSERT_GE(set.BlackHeight(), 0);
+    int key = 0;
+    for (int it : set) ASSERT_EQ(it, key++);
+  }
+}
+
+struct MoveOnly {
+  int value;
+  MoveOnly(int v = 0) : value(v) {}
+  MoveOnly(MoveOnly &&other) = default;
+  MoveOnly &operator=(MoveOnly &&other) = default;
+  bool operator<(const MoveOnly &other) const { return value < other.value; }
+};
+
+TEST(SetTest, SetMergeLinear) {
+  SetInspector<int> set, other;
+  for (int i = 0; i < 3000; i += 2) set.insert(i);
+  for (int i = 0; i < 3000; i += 3) other.insert(i);
+  size_t allocations = allocation_count;
+  set.merge(other);
+  ASSERT_EQ(allocation_count.load(), allocations);
+  ASSERT_EQ(set.size(), 2000);
+  ASSERT_EQ(other.size(), 500);
+  ASSERT_GE(set.BlackHeight(), 0);
+  ASSERT_GE(other.BlackHeight(), 0);
+  for (int key : other) ASSERT_EQ(key % 6, 0);
+  s21::Set<int, s21::SingleComp<int>, s21::PoolAllocator> pooled, source;
+  for (int i = 0; i < 100; ++i) (i % 2 ? pooled : source).insert(i);
+  pooled.merge(source);
+  source.clear();
+  ASSERT_EQ(pooled.size(), 100);
+  int i = 0;
+  for (int key : pooled) ASSERT_EQ(key, i++);
+  s21::Set<MoveOnly, s21::SingleComp<MoveOnly>, s21::PoolAllocator> moving,
+      moved;
+  for (int i = 0; i < 10; ++i) (i % 2 ? moving : moved).insert(MoveOnly(i));
+  moving.merge(moved);
+  ASSERT_EQ(moving.size(), 10);
+  ASSERT_TRUE(moved.empty());
+  i = 0;
+  for (const MoveOnly &key : moving) ASSERT_EQ(key.value, i++);
+}
+
+TEST(SetTest, SetNodeHandles) {
+  SetInspector<int> set, other;
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  size_t allocations = allocation_count;
+  for (int i = 0; i < 1000; i += 3) {
+    SetInspector<int>::node_type node = set.extract(i);
+    node.value() = -i;
+    ASSERT_TRUE(other.insert(std::move(node)).inserted);
+  }
+  ASSERT_EQ(allocation_count.load(), allocations);
+  ASSERT_EQ(set.size(), 666);
+  ASSERT_EQ(other.size(), 334);
+  ASSERT_GE(set.BlackHeight(), 0);
+  ASSERT_GE(other.BlackHeight(), 0);
+  ASSERT_EQ(*other.begin(), -999);
+  ASSERT_TRUE(set.extract(set.end()).empty());
+  ASSERT_FALSE(set.insert(SetInspector<int>::node_type()).inserted);
+  s21::Set<int, s21::SingleComp<int>, s21::PoolAllocator> pooled, source;
+  for (int i = 0; i < 10; ++i) (i % 2 ? pooled : source).insert(i);
+  for (int i = 0; i < 10; i += 2) pooled.insert(source.extract(i));
+  auto again = pooled.insert(pooled.extract(pooled.begin()));
+  ASSERT_TRUE(again.inserted);
+  source.clear();
+  ASSERT_EQ(pooled.size(), 10);
+  int i = 0;
+  for (int key : pooled) ASSERT_EQ(key, i++);
+}
+
+TEST(SetTest, SetPooledNodeHandles) {
+  using PooledSet = s21::Set<int, s21::SingleComp<int>, s21::PoolAllocator>;
+  PooledSet::node_type kept;
+  {
+    PooledSet set;
+    for (int i = 0; i < 100; ++i) set.insert(i);
+    PooledSet::node_type node = set.extract(50);
+    kept = set.extract(60);
+    set.clear();
+    for (int i = 1000; i < 1100; ++i) set.insert(i);
+    ASSERT_EQ(node.value(), 50);
+    set.erase(set.begin(), set.end());
+    ASSERT_TRUE(set.insert(std::move(node)).inserted);
+    // The handle keeps to the pool of its node when trees swap pools.
+    PooledSet other = {7};
+    PooledSet::node_type seven = other.extract(7);
+    set.swap(other);
+    other.clear();
+    ASSERT_TRUE(set.insert(std::move(seven)).inserted);
+    ASSERT_EQ(*set.begin(), 7);
+    ASSERT_TRUE(other.insert(std::move(kept)).inserted);
+    kept = other.extract(other.find(60));
+  }
+  ASSERT_EQ(kept.value(), 60);
+  int before = Tracked::alive;
+  {
+    using TrackedSet =
+        s21::Set<Tracked, s21::SingleComp<Tracked>, s21::PoolAllocator>;
+    TrackedSet::node_type node;
+    {
+      TrackedSet set;
+      for (int i = 0; i < 100; ++i) set.insert(i);
+      node = set.extract(set.begin());
+      set.clear();
+      // The handle and the two sentinels of the set.
+      ASSERT_EQ(Tracked::alive, before + 3);
+      set.insert(5);
+    }
+    ASSERT_EQ(node.value().value, 0);
+  }
+  ASSERT_EQ(Tracked::alive, before);
+}
+
+TEST(SetTest, SetInPlaceInsertion) {
+  s21::Set<std::string> set;
+  std::string value(100, 'v');
+  const char *data = value.data();
+  size_t before = allocation_count;
+  ASSERT_TRUE(set.insert(std::move(value)).second);
+  ASSERT_EQ(allocation_count - before, 1);
+  ASSERT_EQ((*set.begin()).data(), data);
+  before = allocation_count;
+  ASSERT_TRUE(set.emplace(100, 'w').second);
+  ASSERT_EQ(allocation_count - before, 2);
+  value.assign(100, 'v');
+  before = allocation_count;
+  ASSERT_FALSE(set.insert(std::move(value)).second);
+  ASSERT_EQ(allocation_count - before, 0);
+  ASSERT_EQ(value.size(), 100);
+  ASSERT_FALSE(set.emplace(100, 'w').second);
+  ASSERT_EQ(set.size(), 2);
+}
+
+TEST(SetTest, SetInsertMany) {
+  SetInspector<int> set;
+  auto results = set.insert_many(5, 1, 3, 1, 9);
+  ASSERT_EQ(results.size(), 5);
+  ASSERT_EQ(*results[0].first, 5);
+  ASSERT_TRUE(results[1].second);
+  ASSERT_FALSE(results[3].second);
+  ASSERT_TRUE(results[3].first == results[1].first);
+  ASSERT_EQ(set.size(), 4);
+  results = set.insert_many(4, 9, 0);
+  ASSERT_TRUE(results[0].second && results[2].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(*results[1].first, 9);
+  std::vector<int> batch;
+  std::set<int> expected = {0, 1, 3, 4, 5, 9};
+  std::srand(23);
+  for (int i = 0; i < 5000; ++i) batch.push_back(std::rand() % 8000);
+  for (int round = 0; round < 3; ++round) {
+    results = set.insert_range(batch.begin(), batch.end());
+    for (size_t i = 0; i < batch.size(); ++i) {
+      ASSERT_EQ(*results[i].first, batch[i]);
+      ASSERT_EQ(results[i].second, expected.insert(batch[i]).second);
+    }
+    ASSERT_GE(set.BlackHeight(), 0);
+    for (int &key : batch) key += 3000;
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  auto expected_it = expected.begin();
+  for (int key : set) ASSERT_EQ(key, *expected_it++);
+}
+
+TEST(SetTest, SetFindMany) {
+  s21::Set<int> set;
+  for (int i = 0; i < 1000; i += 2) set.insert(i);
+  std::vector<int> keys;
+  std::srand(31);
+  for (int i = 0; i < 1001; ++i) keys.push_back(std::rand() % 1200 - 100);
+  std::vector<s21::Set<int>::iterator> found;
+  set.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  std::vector<bool> present(keys.size());
+  auto end = set.contains_many(keys.begin(), keys.end(), present.begin());
+  ASSERT_TRUE(end == present.end());
+  ASSERT_EQ(found.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_TRUE(found[i] == set.find(keys[i]));
+    ASSERT_EQ(present[i], set.contains(keys[i]));
+  }
+  s21::Set<int> empty;
+  bool none[3] = {true, true, true};
+  empty.contains_many(keys.begin(), keys.begin() + 3, none);
+  for (bool found : none) ASSERT_FALSE(found);
+}
+
+TEST(SetTest, SetFindManyByValue) {
+  s21::Set<bool> set = {true};
+  std::vector<bool> keys = {false, true, true, false};
+  bool present[4];
+  set.contains_many(keys.begin(), keys.end(), present);
+  ASSERT_TRUE(!present[0] && present[1] && present[2] && !present[3]);
+  std::stringstream words("b a c b");
+  s21::Set<std::string> letters = {"a", "b"};
+  std::vector<s21::Set<std::string>::iterator> found;
+  letters.find_many(std::istream_iterator<std::string>(words),
+                    std::istream_iterator<std::string>(),
+                    std::back_inserter(found));
+  ASSERT_EQ(found.size(), 4u);
+  ASSERT_EQ(*found[0], "b");
+  ASSERT_EQ(*found[1], "a");
+  ASSERT_TRUE(found[2] == letters.end());
+  ASSERT_EQ(*found[3], "b");
+}
+
+TEST(SetTest, SetInsertHint) {
+  s21::Set<int, CountingComp> set;
+  CountingComp::calls = 0;
+  for (int i = 0; i < 1000; ++i) set.insert(set.end(), i);
+  ASSERT_LE(CountingComp::calls, 2 * 1000);
+  CountingComp::calls = 0;
+  for (int i = -1; i >= -1000; --i) set.insert(set.begin(), i);
+  ASSERT_LE(CountingComp::calls, 2 * 1000);
+  ASSERT_EQ(*set.insert(set.begin(), 500), 500);
+  ASSERT_EQ(set.size(), 2000);
+  SetInspector<int> checked;
+  std::srand(8);
+  for (int i = 0; i < 3000; ++i) {
+    int key = std::rand() % 2000;
+    auto hint = i % 2 ? checked.lower_bound(key) : checked.begin();
+    ASSERT_EQ(*checked.insert(hint, key), key);
+  }
+  ASSERT_GE(checked.BlackHeight(), 0);
+  auto it = checked.emplace_hint(checked.end(), 2000);
+  ASSERT_EQ(*it, 2000);
+  ASSERT_TRUE(++it == checked.end());
+  int prev = -1;
+  for (int key : checked) {
+    ASSERT_LT(prev, key);
+    prev = key;
+  }
+}
+
+TEST(MapTest, MapInsertHint) {
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 100; ++i)
+    map.insert(map.end(), std::make_pair(i, std::to_string(i)));
+  auto it = map.emplace_hint(map.find(50), 50, "fifty");
+  ASSERT_EQ((*it).second, "50");
+  it = map.emplace_hint(map.begin(), -1, "minus one");
+  ASSERT_EQ((*map.begin()).second, "minus one");
+  ASSERT_EQ(map.size(), 101);
+  int key = -1;
+  for (auto item : map) ASSERT_EQ(item.first, key++);
+}
+
+TEST(MapTest, MapAlgebra) {
+  s21::Map<int, std::string> map = {{1, "a"}, {2, "b"}, {3, "c"}};
+  s21::Map<int, std::string> other = {{2, "x"}, {4, "y"}};
+  map.set_union(other);
+  ASSERT_EQ(map.size(), 4);
+  ASSERT_EQ(map.at(2), "b");
+  ASSERT_EQ(map.at(4), "y");
+  map.set_symmetric_difference(other);
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_TRUE(map.contains(1) && map.contains(3));
+  map.set_union(other);
+  map.set_intersection(other);
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map.at(4), "y");
+  map.set_difference(other);
+  ASSERT_TRUE(map.empty());
+  map.insert(4, "z");
+  map.merge(other);
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map.at(4), "z");
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(other.at(4), "y");
+  map.set_union(map);
+  map.set_intersection(map);
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map.at(4), "z");
+  map.set_symmetric_difference(map);
+  ASSERT_TRUE(map.empty());
+  other.set_difference(other);
+  ASSERT_TRUE(other.empty());
+}
+
+// S21_BTREE
+template <class Key>
+class BTreeInspector : public s21::BTreeSet<Key> {
+ public:
+  using node = typename s21::BTreeSet<Key>::Node;
+
+  // Returns the depth shared by all leaves, or -1 if a node is under- or
+  // overfull, out of order or wrongly linked to its parent.
+  int LeafDepth() { return this->root_ ? LeafDepth(this->root_) : 0; }
+
+ private:
+  int LeafDepth(node *current) {
+    int count = current->count_;
+    if (count > s21::BTreeSet<Key>::kMaxValues) return -1;
+    if (current != this->root_ && count < s21::BTreeSet<Key>::kMinValues)
+      return -1;
+    for (int i = 1; i < count; ++i)
+      if (!(current->values_[i - 1] < current->values_[i])) return -1;
+    if (current->leaf_) return 1;
+    int depth = 0;
+    for (int i = 0; i <= count; ++i) {
+      node *child = this->Child(current, i);
+      if (child->parent_ != current || child->position_ != i) return -1;
+      int child_depth = LeafDepth(child);
+      if (child_depth < 0 || (depth && child_depth != depth)) return -1;
+      depth = child_depth;
+    }
+    return depth + 1;
+  }
+};
+
+TEST(BTreeTest, BTreeSetMatchesStdSet) {
+  BTreeInspector<int> set;
+  std::set<int> expected;
+  std::srand(21);
+  for (int i = 0; i < 20000; ++i) {
+    int key = std::rand() % 5000;
+    if (std::rand() % 3) {
+      ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+      ASSERT_EQ(*set.find(key), key);
+    } else {
+      auto it = set.find(key);
+      ASSERT_EQ(it != set.end(), expected.erase(key) == 1);
+      if (it != set.end()) {
+        auto next = expected.lower_bound(key);
+        it = set.erase(it);
+        if (next == expected.end()) {
+          ASSERT_TRUE(it == set.end());
+        } else {
+          ASSERT_EQ(*it, *next);
+        }
+      }
+    }
+  }
+  ASSERT_GT(set.LeafDepth(), 1);
+  ASSERT_EQ(set.size(), expected.size());
+  auto expected_it = expected.begin();
+  for (auto it : set) ASSERT_EQ(it, *expected_it++);
+  auto it = set.end();
+  for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit)
+    ASSERT_EQ(*--it, *rit);
+  ASSERT_TRUE(it == set.begin());
+}
+
+TEST(BTreeTest, BTreeSetBounds) {
+  s21::BTreeSet<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i * 2);
+  ASSERT_EQ(*set.lower_bound(7), 8);
+  ASSERT_EQ(*set.lower_bound(8), 8);
+  ASSERT_EQ(*set.upper_bound(8), 10);
+  ASSERT_TRUE(set.lower_bound(1999) == set.end());
+  ASSERT_EQ(set.count(998), 1);
+  ASSERT_FALSE(set.contains(999));
+  auto range = set.equal_range(500);
+  ASSERT_EQ(*range.first, 500);
+  ASSERT_EQ(*range.second, 502);
+  range = set.equal_range(501);
+  ASSERT_TRUE(range.first == range.second);
+}
+
+TEST(BTreeTest, BTreeSetEraseRange) {
+  BTreeInspector<int> set;
+  for (int i = 0; i < 3000; ++i) set.insert(i);
+  auto it = set.erase(set.lower_bound(1000), set.lower_bound(2500));
+  ASSERT_EQ(*it, 2500);
+  ASSERT_EQ(set.size(), 1500);
+  ASSERT_GT(set.LeafDepth(), 0);
+  for (it = set.begin(); it != set.end();) it = *it % 2 ? set.erase(it) : ++it;
+  ASSERT_EQ(set.size(), 750);
+  ASSERT_GT(set.LeafDepth(), 0);
+  set.erase(set.begin(), set.end());
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(BTreeTest, BTreeSetCopyMerge) {
+  s21::BTreeSet<std::string> set = {"a", "c", "e"};
+  s21::BTreeSet<std::string> copy(set);
+  copy.erase(copy.find("a"));
+  ASSERT_TRUE(set.contains("a"));
+  s21::BTreeSet<std::string> other = {"b", "c", "d"};
+  set.merge(other);
+  ASSERT_EQ(set.size(), 5);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(*other.begin(), "c");
+  copy = std::move(set);
+  ASSERT_EQ(copy.size(), 5);
+  ASSERT_TRUE(set.empty());
+}
+
+// The copy after throw_after more throws; a negative count never does.
+struct ThrowsOnCopy {
+  static int throw_after;
+  int value;
+  ThrowsOnCopy(int v = 0) : value(v) {}
+  ThrowsOnCopy(const ThrowsOnCopy &other) : value(other.value) {
+    if (throw_after >= 0 && throw_after-- == 0)
+      throw std::runtime_error("copy");
+  }
+  ThrowsOnCopy &operator=(const ThrowsOnCopy &other) = default;
+  bool operator<(const ThrowsOnCopy &other) const {
+    return value < other.value;
+  }
+  bool operator==(const ThrowsOnCopy &other) const {
+    return value == other.value;
+  }
+};
+
+int ThrowsOnCopy::throw_after = -1;
+
+struct ThrowsOnCopyHash {
+  size_t operator()(const ThrowsOnCopy &item) const {
+    return std::hash<int>()(item.value);
+  }
+};
+
+TEST(BTreeTest, BTreeSetThrowingFirstInsert) {
+  BTreeInspector<ThrowsOnCopy> set;
+  ThrowsOnCopy::throw_after = 0;
+  ASSERT_THROW(set.insert(ThrowsOnCopy(1)), std::runtime_error);
+  ThrowsOnCopy::throw_after = -1;
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(set.LeafDepth(), 0);
+  ASSERT_TRUE(set.insert(ThrowsOnCopy(2)).second);
+  ASSERT_EQ(set.LeafDepth(), 1);
+  ASSERT_EQ((*set.begin()).value, 2);
+}
+
+TEST(BTreeTest, BTreeSetFailingSplits) {
+  BTreeInspector<int> set;
+  const int count = 5000;
+  for (int i = 0; i < count; ++i) {
+    int key = i * 7919 % count;
+    // Splits allocate one node per level and one more for a new root; the
+    // first and the second allocation of each insertion fail in turn.
+    for (int allowed : {0, 1}) {
+      size_t size = set.size();
+      allocations_before_failure = allowed;
+      try {
+        set.insert(key);
+        allocations_before_failure = -1;
+        break;
+      } catch (const std::bad_alloc &) {
+        allocations_before_failure = -1;
+        ASSERT_EQ(set.size(), size);
+        ASSERT_FALSE(set.contains(key));
+        ASSERT_GE(set.LeafDepth(), 0);
+      }
+    }
+    set.insert(key);
+  }
+  ASSERT_EQ(set.size(), count);
+  ASSERT_GT(set.LeafDepth(), 2);
+  int expected = 0;
+  for (int key : set) ASSERT_EQ(key, expected++);
+}
+
+// Has no default constructor.
+struct Boxed {
+  explicit Boxed(int v) : value(v) {}
+  bool operator<(const Boxed &other) const { return value < other.value; }
+  int value;
+};
+
+TEST(BTreeTest, BTreeSetBuildsOnlyItsElements) {
+  int before = Tracked::alive;
+  {
+    BTreeInspector<Tracked> set;
+    for (int i = 0; i < 1000; ++i) set.insert(i);
+    ASSERT_EQ(Tracked::alive, before + 1000);
+    for (int i = 0; i < 1000; i += 3) set.erase(set.find(Tracked(i)));
+    ASSERT_EQ(Tracked::alive, before + static_cast<int>(set.size()));
+    ASSERT_GT(set.LeafDepth(), 0);
+    BTreeInspector<Tracked> copy(set);
+    ASSERT_EQ(Tracked::alive, before + 2 * static_cast<int>(set.size()));
+  }
+  ASSERT_EQ(Tracked::alive, before);
+  s21::BTreeSet<Boxed> boxes;
+  for (int i = 0; i < 100; ++i) boxes.insert(Boxed(i * 7 % 100));
+  ASSERT_EQ((*boxes.begin()).value, 0);
+}
+
+TEST(BTreeTest, BTreeMapAccess) {
+  s21::BTreeMap<int, std::string> map = {{1, "one"}, {2, "two"}};
+  map[3] = "three";
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_THROW(map.at(4), std::out_of_range);
+  ASSERT_FALSE(map.insert(1, "uno").second);
+  ASSERT_EQ(map[1], "one");
+  map.insert_or_assign(1, "uno");
+  ASSERT_EQ(map.at(1), "uno");
+  for (int i = 4; i < 1000; ++i) map.insert(i, std::to_string(i));
+  ASSERT_EQ(map.size(), 999);
+  ASSERT_EQ((*map.find(500)).second, "500");
+  ASSERT_TRUE(map.lower_bound(1000) == map.end());
+  int key = 0;
+  for (auto item : map) ASSERT_EQ(item.first, ++key);
+  map.erase(map.find(500));
+  ASSERT_FALSE(map.contains(500));
+  ASSERT_EQ((*map.upper_bound(499)).first, 501);
+}
+
+// S21_FLAT
+TEST(FlatTest, FlatSetMatchesStdSet) {
+  s21::FlatSet<int> set;
+  std::set<int> expected;
+  std::srand(13);
+  for (int i = 0; i < 5000; ++i) {
+    int key = std::rand() % 2000;
+    if (std::rand() % 3) {
+      ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+    } else if (set.contains(key)) {
+      set.erase(set.find(key));
+      expected.erase(key);
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  auto expected_it = expected.begin();
+  for (auto it : set) ASSERT_EQ(it, *expected_it++);
+  ASSERT_EQ(*set.lower_bound(1000), *expected.lower_bound(1000));
+  ASSERT_EQ(*set.upper_bound(1000), *expected.upper_bound(1000));
+}
+
+TEST(FlatTest, FlatSetInsertMany) {
+  s21::FlatSet<std::string> set = {"d", "b", "b", "f"};
+  ASSERT_EQ(set.size(), 3);
+  std::vector<std::string> batch = {"e", "a", "d", "e", "c"};
+  set.insert_many(batch.begin(), batch.end());
+  ASSERT_EQ(set.size(), 6);
+  std::string letters;
+  for (auto it : set) letters += it;
+  ASSERT_EQ(letters, "abcdef");
+  s21::FlatSet<std::string> other = {"a", "g"};
+  set.merge(other);
+  ASSERT_EQ(set.size(), 7);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(*other.begin(), "a");
+  auto it = set.erase(set.find("b"), set.find("e"));
+  ASSERT_EQ(*it, "e");
+  ASSERT_EQ(set.size(), 4);
+}
+
+TEST(FlatTest, FlatMapAccess) {
+  s21::FlatMap<int, std::string> map = {{2, "two"}, {1, "one"}};
+  map[3] = "three";
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_THROW(map.at(4), std::out_of_range);
+  ASSERT_FALSE(map.insert(1, "uno").second);
+  map.insert_or_assign(1, "uno");
+  ASSERT_EQ(map.at(1), "uno");
+  map.insert_many({{5, "five"}, {2, "deux"}, {4, "four"}});
+  ASSERT_EQ(map.size(), 5);
+  ASSERT_EQ(map[2], "two");
+  int key = 0;
+  for (auto item : map) ASSERT_EQ(item.first, ++key);
+  s21::FlatMap<int, std::string> copy(map);
+  map.erase(map.find(3));
+  ASSERT_FALSE(map.contains(3));
+  ASSERT_TRUE(copy.contains(3));
+  ASSERT_EQ((*map.upper_bound(2)).first, 4);
+}
+
+// Counts its copies; moves are free.
+struct CopyCounted {
+  static int copies;
+  CopyCounted() = default;
+  CopyCounted(const CopyCounted &) { ++copies; }
+  CopyCounted(CopyCounted &&) noexcept = default;
+  CopyCounted &operator=(const CopyCounted &) {
+    ++copies;
+    return *this;
+  }
+  CopyCounted &operator=(CopyCounted &&) noexcept = default;
+};
+
+int CopyCounted::copies = 0;
+
+TEST(FlatTest, FlatMapShiftsByMove) {
+  s21::FlatMap<std::string, CopyCounted> map;
+  for (int i = 100; i < 200; ++i) map.insert(std::to_string(i), {});
+  CopyCounted::copies = 0;
+  map.insert("0", CopyCounted());
+  map.erase(map.begin());
+  ASSERT_EQ(CopyCounted::copies, 1);
+  ASSERT_EQ(map.size(), 100);
+  int before = Tracked::alive;
+  {
+    s21::FlatSet<Tracked> set = {3, 1, 2};
+    set.erase(set.begin());
+    ASSERT_EQ(Tracked::alive, before + 2);
+    set.clear();
+    ASSERT_EQ(Tracked::alive, before);
+  }
+  ASSERT_EQ(Tracked::alive, before);
+}
+
+// S21_FROZEN
+TEST(FrozenTest, FrozenSetMatchesStdSet) {
+  for (int n : {0, 1, 2, 3, 7, 8, 100, 1000}) {
+    s21::Set<int> source;
+    std::set<int> expected;
+    for (int i = 0; i < n; ++i) {
+      source.insert(3 * i);
+      expected.insert(3 * i);
+    }
+    const s21::FrozenSet<int> frozen = source.freeze();
+    ASSERT_EQ(frozen.size(), expected.size());
+    auto expected_it = expected.begin();
+    for (auto it : frozen) ASSERT_EQ(it, *expected_it++);
+    for (int key = -1; key <= 3 * n; ++key) {
+      ASSERT_EQ(frozen.contains(key), expected.count(key) == 1);
+      auto lower = expected.lower_bound(key);
+      auto upper = expected.upper_bound(key);
+      ASSERT_EQ(frozen.lower_bound(key) == frozen.end(),
+                lower == expected.end());
+      if (lower != expected.end()) {
+        ASSERT_EQ(*frozen.lower_bound(key), *lower);
+      }
+      if (upper != expected.end()) {
+        ASSERT_EQ(*frozen.upper_bound(key), *upper);
+      }
+    }
+    auto it = frozen.end();
+    for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit)
+      ASSERT_EQ(*--it, *rit);
+    ASSERT_TRUE(it == frozen.begin());
+  }
+}
+
+TEST(FrozenTest, FrozenMapLookups) {
+  s21::Map<std::string, int> source = {{"b", 2}, {"a", 1}, {"c", 3}};
+  s21::FrozenMap<std::string, int> frozen = source.freeze();
+  source.clear();
+  ASSERT_EQ(frozen.at("b"), 2);
+  ASSERT_THROW(frozen.at("d"), std::out_of_range);
+  ASSERT_TRUE(frozen.find("e") == frozen.end());
+  ASSERT_EQ((*frozen.lower_bound("bb")).first, "c");
+  s21::FrozenMap<int, int> unsorted = {{5, 50}, {1, 10}, {5, 55}, {3, 30}};
+  ASSERT_EQ(unsorted.size(), 3);
+  ASSERT_EQ(unsorted.at(5), 50);
+  s21::FrozenSet<std::string> words = {"pear", "fig", "apple", "fig"};
+  std::string joined;
+  for (auto word : words) joined += word;
+  ASSERT_EQ(joined, "applefigpear");
+}
+
+// S21_UNORDERED
+TEST(UnorderedTest, UnorderedSetMatchesStdSet) {
+  s21::UnorderedSet<int> set;
+  std::set<int> expected;
+  std::srand(17);
+  // Heavy churn on few keys leaves many deleted slots to be reused.
+  for (int i = 0; i < 50000; ++i) {
+    int key = std::rand() % 3000;
+    if (std::rand() % 2) {
+      ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+    } else if (set.contains(key)) {
+      set.erase(set.find(key));
+      expected.erase(key);
+    } else {
+      ASSERT_EQ(expected.count(key), 0);
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  std::set<int> walked;
+  for (auto key : set) ASSERT_TRUE(walked.insert(key).second);
+  ASSERT_TRUE(walked == expected);
+  ASSERT_LE(set.load_factor(), set.max_load_factor());
+}
+
+TEST(UnorderedTest, UnorderedSetCapacity) {
+  s21::UnorderedSet<std::string> set;
+  ASSERT_TRUE(set.begin() == set.end());
+  ASSERT_TRUE(set.find("a") == set.end());
+  set.reserve(1000);
+  size_t buckets = set.bucket_count();
+  ASSERT_GE(buckets * set.max_load_factor(), 1000);
+  for (int i = 0; i < 1000; ++i) set.insert(std::to_string(i));
+  ASSERT_EQ(set.bucket_count(), buckets);
+  for (auto it = set.begin(); it != set.end();)
+    it = *it == "7" ? ++it : set.erase(it);
+  ASSERT_EQ(set.size(), 1);
+  set.rehash(0);
+  ASSERT_EQ(set.bucket_count(), s21::UnorderedSet<int>::kGroupWidth - 1);
+  ASSERT_EQ(*set.begin(), "7");
+  s21::UnorderedSet<std::string> copy(set);
+  s21::UnorderedSet<std::string> other = {"7", "8"};
+  copy.merge(other);
+  ASSERT_EQ(copy.size(), 2);
+  ASSERT_EQ(other.size(), 1);
+  set.clear();
+  set.rehash(0);
+  ASSERT_EQ(set.bucket_count(), 0);
+  ASSERT_TRUE(copy.contains("8"));
+}
+
+TEST(UnorderedTest, UnorderedSetThrowingCopies) {
+  using ThrowingSet = s21::UnorderedSet<ThrowsOnCopy, ThrowsOnCopyHash>;
+  ThrowingSet set;
+  // Fifteen slots take fourteen elements, so the next insertion grows.
+  for (int i = 0; i < 14; ++i) set.insert(i);
+  ASSERT_EQ(set.bucket_count(), 15);
+  ThrowsOnCopy::throw_after = 5;
+  ASSERT_THROW(set.insert(14), std::runtime_error);
+  ThrowsOnCopy::throw_after = 5;
+  ASSERT_THROW(ThrowingSet copy(set), std::runtime_error);
+  ThrowsOnCopy::throw_after = -1;
+  ASSERT_EQ(set.bucket_count(), 15);
+  ASSERT_EQ(set.size(), 14);
+  for (int i = 0; i < 14; ++i) ASSERT_TRUE(set.contains(i));
+  ASSERT_TRUE(set.insert(14).second);
+  ASSERT_GT(set.bucket_count(), 15);
+  for (int i = 0; i < 15; ++i) ASSERT_TRUE(set.contains(i));
+}
+
+TEST(UnorderedTest, UnorderedMapAccess) {
+  s21::UnorderedMap<int, std::string> map = {{2, "two"}, {1, "one"}};
+  map[3] = "three";
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_THROW(map.at(4), std::out_of_range);
+  ASSERT_FALSE(map.insert(1, "uno").second);
+  map.insert_or_assign(1, "uno");
+  ASSERT_EQ(map.at(1), "uno");
+  for (int key = 4; key < 2000; ++key) map[key] = std::to_string(key);
+  ASSERT_EQ(map.size(), 1999);
+  ASSERT_EQ(map[1500], "1500");
+  s21::UnorderedMap<int, std::string> moved(std::move(map));
+  ASSERT_EQ(moved.count(2), 1);
+  moved.erase(moved.find(2));
+  ASSERT_FALSE(moved.contains(2));
+  map = moved;
+  ASSERT_EQ(map.size(), 1998);
+  ASSERT_EQ((*map.find(3)).second, "three");
+}
+
+// S21_MULTISET
+TEST(MultisetTest, MultisetMatchesStdMultiset) {
+  s21::Multiset<int> set;
+  s21::RunLengthMultiset<int> runs;
+  std::multiset<int> expected;
+  std::srand(16);
+  for (int i = 0; i < 4000; ++i) {
+    int key = std::rand() % 100;
+    if (std::rand() % 4) {
+      ASSERT_EQ(*set.insert(key), key);
+      ASSERT_EQ(*runs.insert(key), key);
+      expected.insert(key);
+    } else if (expected.count(key)) {
+      auto next = set.erase(set.find(key));
+      auto run_next = runs.erase(runs.find(key));
+      expected.erase(expected.find(key));
+      auto expected_next = expected.lower_bound(key);
+      if (expected_next == expected.end()) {
+        ASSERT_TRUE(next == set.end());
+        ASSERT_TRUE(run_next == runs.end());
+      } else {
+        ASSERT_EQ(*next, *expected_next);
+        ASSERT_EQ(*run_next, *expected_next);
+      }
+    }
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  ASSERT_EQ(runs.size(), expected.size());
+  ASSERT_LE(runs.distinct(), 100);
+  auto it = set.begin();
+  auto run_it = runs.begin();
+  for (int key : expected) {
+    ASSERT_EQ(*it++, key);
+    ASSERT_EQ(*run_it++, key);
+  }
+  ASSERT_TRUE(run_it == runs.end());
+  for (int key = 0; key < 100; ++key) {
+    ASSERT_EQ(set.count(key), expected.count(key));
+    ASSERT_EQ(runs.count(key), expected.count(key));
+  }
+  for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit)
+    ASSERT_EQ(*--run_it, *rit);
+}
+
+// Orders pairs by their first member only, so equal keys can be told apart.
+struct KeyOnlyComp {
+  int Compare(const std::pair<int, int> &a,
+              const std::pair<int, int> &b) const {
+    return a.first < b.first ? -1 : a.first > b.first;
+  }
+  bool LessThan(const std::pair<int, int> &a,
+                const std::pair<int, int> &b) const {
+    return a.first < b.first;
+  }
+};
+
+TEST(MultisetTest, MultisetInsertMany) {
+  s21::Multiset<std::pair<int, int>, KeyOnlyComp> multiset;
+  multiset.insert({2, 0});
+  auto results = multiset.insert_many(std::make_pair(2, 1),
+                                      std::make_pair(1, 2),
+                                      std::make_pair(2, 3));
+  ASSERT_TRUE(results[0].second && results[1].second && results[2].second);
+  std::vector<std::pair<int, int>> batch = {{1, 4}, {3, 5}, {2, 6}};
+  multiset.insert_range(batch.begin(), batch.end());
+  ASSERT_EQ(multiset.size(), 7);
+  std::vector<int> order;
+  for (auto item : multiset) order.push_back(item.second);
+  ASSERT_EQ(order, std::vector<int>({2, 4, 0, 1, 3, 6, 5}));
+}
+
+TEST(MultisetTest, MultisetBounds) {
+  s21::Multiset<std::string> set = {"b", "a", "b", "c", "b"};
+  ASSERT_EQ(set.size(), 5);
+  ASSERT_EQ(set.count("b"), 3);
+  ASSERT_EQ(set.count("d"), 0);
+  auto range = set.equal_range("b");
+  ASSERT_EQ(*range.first, "b");
+  ASSERT_EQ(*range.second, "c");
+  ASSERT_TRUE(set.find("b") == range.first);
+  ASSERT_TRUE(set.find("bb") == set.end());
+  ASSERT_EQ(*set.upper_bound("a"), "b");
+  s21::Multiset<std::string> other = {"b", "d"};
+  set.merge(other);
+  ASSERT_EQ(set.size(), 7);
+  ASSERT_TRUE(other.empty());
+  ASSERT_EQ(set.count("b"), 4);
+  s21::RunLengthMultiset<std::string> runs = {"x", "x", "y"};
+  s21::RunLengthMultiset<std::string> more = {"y", "z"};
+  runs.merge(more);
+  ASSERT_EQ(runs.size(), 5);
+  ASSERT_EQ(runs.distinct(), 3);
+  ASSERT_EQ(runs.count("y"), 2);
+  ASSERT_TRUE(more.empty());
+  auto run_range = runs.equal_range("x");
+  int copies = 0;
+  for (; run_range.first != run_range.second; ++run_range.first) ++copies;
+  ASSERT_EQ(copies, 2);
+}
+
+TEST(MultisetTest, RunLengthHeavyDuplicates) {
+  s21::RunLengthMultiset<int> runs;
+  size_t allocations = allocation_count;
+  for (int i = 0; i < 10000; ++i) runs.insert(i % 4);
+  ASSERT_EQ(allocation_count - allocations, 4);
+  ASSERT_EQ(runs.count(3), 2500);
+  s21::RunLengthMultiset<int> copy(runs);
+  copy.clear();
+  ASSERT_EQ(runs.size(), 10000);
+}
+
+TEST(MultisetTest, RunLengthInsertMany) {
+  s21::RunLengthMultiset<int> runs = {2, 5};
+  auto results = runs.insert_many(5, 1, 5, 2);
+  ASSERT_EQ(runs.size(), 6);
+  ASSERT_EQ(runs.distinct(), 3);
+  ASSERT_EQ(runs.count(5), 3);
+  ASSERT_EQ(runs.count(1), 1);
+  for (auto &result : results) ASSERT_TRUE(result.second);
+  ASSERT_EQ(*results[0].first, 5);
+  ASSERT_EQ(*results[1].first, 1);
+  ASSERT_TRUE(results[1].first == runs.begin());
+  ASSERT_NE(results[0].first.index(), results[2].first.index());
+  ASSERT_EQ(results[3].first.index(), 1);
+  std::vector<int> batch = {7, 1, 7, 7};
+  results = runs.insert_range(batch.begin(), batch.end());
+  ASSERT_EQ(results.size(), 4);
+  ASSERT_EQ(runs.size(), 10);
+  ASSERT_EQ(runs.count(7), 3);
+  ASSERT_EQ(runs.count(1), 2);
+  ASSERT_TRUE(++results[1].first == runs.find(2));
+  std::vector<int> all;
+  for (int key : runs) all.push_back(key);
+  ASSERT_EQ(all, std::vector<int>({1, 1, 2, 2, 5, 5, 5, 7, 7, 7}));
+}
+
+TEST(MultisetTest, RunLengthMergeLinear) {
+  s21::RunLengthMultiset<int> runs, other;
+  for (int i = 0; i < 3000; ++i) runs.insert(i % 1000 * 2);
+  for (int i = 0; i < 3000; ++i) other.insert(i % 1000 * 3);
+  size_t allocations = allocation_count;
+  runs.merge(other);
+  ASSERT_EQ(allocation_count.load(), allocations);
+  ASSERT_EQ(runs.size(), 6000);
+  ASSERT_EQ(runs.distinct(), 1666);
+  ASSERT_EQ(runs.count(6), 6);
+  ASSERT_EQ(runs.count(3), 3);
+  ASSERT_EQ(runs.count(2), 3);
+  ASSERT_TRUE(other.empty());
+  ASSERT_EQ(other.distinct(), 0);
+  runs.merge(runs);
+  ASSERT_EQ(runs.size(), 6000);
+  size_t copies = 0;
+  for (auto it = runs.begin(); it != runs.end(); ++it) ++copies;
+  ASSERT_EQ(copies, 6000);
+}
+
+TEST(MultisetTest, MultimapBasics) {
+  s21::Multimap<int, std::string> map = {{2, "b"}, {1, "a"}, {2, "bb"}};
+  map.insert(2, "bbb");
+  ASSERT_EQ(map.size(), 4);
+  ASSERT_EQ(map.count(2), 3);
+  std::string values;
+  for (auto range = map.equal_range(2); range.first != range.second;
+       ++range.first)
+    values += (*range.first).second + " ";
+  ASSERT_EQ(values, "b bb bbb ");
+  ASSERT_EQ((*map.find(2)).second, "b");
+  map.erase(map.find(2));
+  ASSERT_EQ((*map.find(2)).second, "bb");
+  s21::Multimap<int, std::string> other = {{1, "z"}};
+  map.merge(other);
+  ASSERT_EQ(map.count(1), 2);
+  ASSERT_EQ((*map.upper_bound(0)).second, "a");
+  ASSERT_TRUE(map.contains(1));
+  ASSERT_FALSE(map.contains(3));
+}
+
+// S21_CONCURRENT_MAP
+TEST(ConcurrentMapTest, ConcurrentWriters) {
+  s21::ConcurrentMap<int, int> map(8);
+  ASSERT_EQ(map.shard_count(), 8);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&map, t] {
+      for (int i = t * 1000; i < (t + 1) * 1000; ++i) {
+        map.insert(i, i);
+        map.insert_or_assign(i, -i);
+        if (i % 10 == 0) map.erase(i);
+        map.contains(i / 2);
+      }
+    });
+  for (auto &thread : threads) thread.join();
+  ASSERT_EQ(map.size(), 3600);
+  ASSERT_EQ(*map.find(7), -7);
+  ASSERT_FALSE(map.find(10).has_value());
+  ASSERT_FALSE(map.insert(7, 0));
+  ASSERT_EQ(map.erase(7), 1);
+  ASSERT_EQ(map.erase(7), 0);
+}
+
+TEST(ConcurrentMapTest, ConcurrentSnapshots) {
+  s21::ConcurrentMap<int, long long> map(4);
+  for (int i = 0; i < 1000; ++i) map.insert(i, 1);
+  std::thread writer([&map] {
+    for (int round = 0; round < 50; ++round)
+      for (int i = 0; i < 1000; i += 7) map.insert_or_assign(i, round);
+  });
+  for (int round = 0; round < 20; ++round) {
+    size_t total = 0;
+    for (auto &shard : map.snapshot()) total += shard.size();
+    ASSERT_EQ(total, 1000);
+  }
+  writer.join();
+  long long sum = 0;
+  size_t visited = 0;
+  map.for_each([&](const std::pair<int, long long> &item) {
+    sum += item.second;
+    ++visited;
+  });
+  ASSERT_EQ(visited, 1000);
+  ASSERT_EQ(sum, 1000 - 143 + 143 * 49);
+  map.clear();
+  ASSERT_TRUE(map.empty());
+}
+
+// S21_CONCURRENT_SKIP_LIST
+TEST(ConcurrentSkipSetTest, Lookups) {
+  s21::ConcurrentSkipSet<int> set({5, 1, 9, 3, 7});
+  ASSERT_FALSE(set.insert(3).second);
+  ASSERT_EQ(*set.insert(4).first, 4);
+  ASSERT_EQ(set.size(), 6);
+  ASSERT_TRUE(set.contains(9));
+  ASSERT_FALSE(set.contains(2));
+  ASSERT_EQ(*set.find(7), 7);
+  ASSERT_TRUE(set.find(8) == set.end());
+  ASSERT_EQ(*set.lower_bound(6), 7);
+  ASSERT_EQ(*set.upper_bound(7), 9);
+  ASSERT_TRUE(set.lower_bound(10) == set.end());
+  ASSERT_EQ(set.erase(4), 1);
+  ASSERT_EQ(set.erase(4), 0);
+  ASSERT_EQ(*set.erase(set.find(5)), 7);
+  std::vector<int> keys;
+  for (auto it = set.begin(); it != set.end(); ++it) keys.push_back(*it);
+  ASSERT_EQ(keys, std::vector<int>({1, 3, 7, 9}));
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(ConcurrentSkipSetTest, ConcurrentWriters) {
+  s21::ConcurrentSkipSet<int> set;
+  std::atomic<int> inserted{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&, t] {
+      // Neighbouring threads insert half of their keys both.
+      for (int key = t * 1000; key < t * 1000 + 2000; ++key) {
+        if (set.insert(key).second) ++inserted;
+        set.contains(key + 1);
+      }
+    });
+  for (auto &thread : threads) thread.join();
+  ASSERT_EQ(inserted.load(), 5000);
+  ASSERT_EQ(set.size(), 5000);
+  ASSERT_EQ(set.erase(4000), 1);
+  threads.clear();
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&set, t] {
+      for (int key = t; key < 5000; key += 8) set.erase(key);
+    });
+  for (auto &thread : threads) thread.join();
+  int expected = 4;
+  for (auto it = set.begin(); it != set.end(); ++it) {
+    ASSERT_EQ(*it, expected);
+    expected += expected % 8 == 7 ? 5 : 1;
+  }
+  ASSERT_EQ(expected, 5004);
+  ASSERT_EQ(set.size(), 2500);
+}
+
+TEST(ConcurrentSkipSetTest, ThrowingInsert) {
+  s21::ConcurrentSkipSet<ThrowsOnCopy> set;
+  ThrowsOnCopy item(1);
+  // Each pass lets one more copy through, until the insert gets past every
+  // copy it makes.
+  for (int copies = 0;; ++copies) {
+    ThrowsOnCopy::throw_after = copies;
+    try {
+      set.insert(item);
+      break;
+    } catch (const std::runtime_error &) {
+      ASSERT_TRUE(set.empty());
+    }
+  }
+  ThrowsOnCopy::throw_after = -1;
+  ASSERT_EQ(set.size(), 1);
+  ASSERT_TRUE(set.contains(item));
+}
+
+TEST(ConcurrentSkipSetTest, IterateWhileWriting) {
+  s21::ConcurrentSkipSet<int> set;
+  for (int key = 0; key < 2000; key += 2) set.insert(key);
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (int round = 0; round < 20; ++round) {
+      for (int key = 1; key < 2000; key += 2) set.insert(key);
+      for (int key = 1; key < 2000; key += 2) set.erase(key);
+    }
+    done = true;
+  });
+  while (!done) {
+    // Keys present for the whole walk are always seen, in order.
+    int even = 0;
+    int previous = -1;
+    for (auto it = set.begin(); it != set.end(); ++it) {
+      ASSERT_LT(previous, *it);
+      previous = *it;
+      if (*it % 2 == 0) ++even;
+    }
+    ASSERT_EQ(even, 1000);
+  }
+  writer.join();
+  ASSERT_EQ(set.size(), 1000);
+}
+
+template <class Key>
+class SkipSetInspector : public s21::ConcurrentSkipSet<Key> {
+ public:
+  using node = typename s21::ConcurrentSkipSet<Key>::Node;
+
+  // Whether every level holds only unmarked nodes, in order, that are also
+  // on the bottom level. Only meaningful while no thread writes.
+  bool LevelsConsistent() {
+    std::set<node *> bottom;
+    for (node *it = Next(this->head_, 0); it; it = Next(it, 0))
+      bottom.insert(it);
+    for (int level = 0; level < this->kMaxLevel; ++level) {
+      node *previous = nullptr;
+      for (node *it = Next(this->head_, level); it; it = Next(it, level)) {
+        if (it->link(level).load() & 1 || !bottom.count(it)) return false;
+        if (previous && !(previous->data_ < it->data_)) return false;
+        previous = it;
+      }
+    }
+    return bottom.size() == this->size();
+  }
+
+ private:
+  static node *Next(node *current, int level) {
+    return reinterpret_cast<node *>(current->link(level).load() & ~1);
+  }
+};
+
+TEST(ConcurrentSkipSetTest, InsertEraseSameKeys) {
+  for (int round = 0; round < 100; ++round) {
+    SkipSetInspector<int> set;
+    // Each key is inserted while the eraser already waits for it, so the
+    // erase often meets a node still being linked. Later searches look for
+    // smaller keys and never pass a node left behind on an upper level.
+    std::atomic<int> erased{256};
+    std::thread inserter([&set, &erased] {
+      for (int key = 255; key >= 0; --key) {
+        while (erased.load() > key + 1) std::this_thread::yield();
+        set.insert(key);
+      }
+    });
+    std::thread eraser([&set, &erased] {
+      for (int key = 255; key >= 0; --key) {
+        while (!set.erase(key)) std::this_thread::yield();
+        erased.store(key);
+      }
+    });
+    std::thread reader([&set] {
+      for (int key = 255; key >= 0; --key) {
+        auto it = set.lower_bound(key);
+        if (it != set.end()) {
+          ASSERT_GE(*it, key);
+        }
+      }
+    });
+    inserter.join();
+    eraser.join();
+    reader.join();
+    ASSERT_TRUE(set.LevelsConsistent());
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.begin() == set.end());
+  }
+}
+
+TEST(ConcurrentSkipMapTest, Lookups) {
+  s21::ConcurrentSkipMap<std::string, int> map({{"b", 2}, {"a", 1}});
+  ASSERT_TRUE(map.insert("c", 3).second);
+  ASSERT_FALSE(map.insert({"a", 10}).second);
+  ASSERT_EQ(map.at("a"), 1);
+  ASSERT_THROW(map.at("z"), std::out_of_range);
+  ASSERT_EQ((*map.find("b")).second, 2);
+  ASSERT_EQ((*map.lower_bound("bb")).first, "c");
+  ASSERT_EQ(map.count("c"), 1);
+  ASSERT_EQ(map.erase("b"), 1);
+  std::string keys;
+  for (auto it = map.begin(); it != map.end(); ++it) keys += (*it).first;
+  ASSERT_EQ(keys, "ac");
+}
+
+TEST(ConcurrentSkipMapTest, ConcurrentReplace) {
+  s21::ConcurrentSkipMap<int, std::string> map;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&map, t] {
+      for (int i = 0; i < 3000; ++i) {
+        int key = i % 100;
+        map.erase(key);
+        map.insert(key, std::to_string(t));
+        auto it = map.find(key);
+        if (it != map.end()) {
+          ASSERT_EQ((*it).second.size(), 1);
+        }
+      }
+    });
+  for (auto &thread : threads) thread.join();
+  ASSERT_EQ(map.size(), 100);
+}
+
+// S21_PERSISTENT_MAP
+TEST(PersistentMapTest, VersionsStayIntact) {
+  std::srand(23);
+  std::vector<s21::PersistentMap<int, int>> versions(1);
+  std::vector<std::map<int, int>> expected(1);
+  for (int i = 0; i < 3000; ++i) {
+    int key = std::rand() % 500;
+    std::map<int, int> next = expected.back();
+    if (std::rand() % 3) {
+      versions.push_back(versions.back().insert_or_assign(key, i));
+      next[key] = i;
+    } else {
+      versions.push_back(versions.back().erase(key));
+      next.erase(key);
+    }
+    expected.push_back(next);
+  }
+  for (size_t v = 0; v < versions.size(); v += 97) {
+    ASSERT_EQ(versions[v].size(), expected[v].size());
+    auto expected_it = expected[v].begin();
+    for (auto item : versions[v]) {
+      ASSERT_EQ(item.first, expected_it->first);
+      ASSERT_EQ(item.second, (expected_it++)->second);
+    }
+  }
+  s21::PersistentMap<int, int> last = versions.back();
+  versions.clear();
+  ASSERT_EQ(last.size(), expected.back().size());
+}
+
+TEST(PersistentMapTest, Lookups) {
+  s21::PersistentMap<std::string, int> base = {{"b", 2}, {"d", 4}};
+  s21::PersistentMap<std::string, int> more = base.insert("c", 3);
+  ASSERT_FALSE(base.contains("c"));
+  ASSERT_EQ(more.at("c"), 3);
+  ASSERT_THROW(more.at("a"), std::out_of_range);
+  ASSERT_EQ(more.insert("c", 30).at("c"), 3);
+  ASSERT_EQ(more.insert_or_assign("c", 30).at("c"), 30);
+  ASSERT_EQ((*more.lower_bound("bb")).first, "c");
+  ASSERT_EQ((*more.upper_bound("c")).first, "d");
+  ASSERT_TRUE(more.upper_bound("d") == more.end());
+  ASSERT_EQ((*more.find("d")).second, 4);
+  ASSERT_TRUE(more.erase("z").size() == 3);
+  ASSERT_TRUE(more.erase("b").erase("c").erase("d").empty());
+}
+
+// Orders by key, in the direction chosen when the comparator is made.
+struct FlippedOrder : s21::PairComp<int, int> {
+  static bool next_descending;
+  bool descending = next_descending;
+
+  template <class L, class R>
+  int Compare(const L &a, const R &b) const {
+    int order = s21::PairComp<int, int>::Compare(a, b);
+    return descending ? -order : order;
+  };
+};
+
+bool FlippedOrder::next_descending = false;
+
+TEST(PersistentMapTest, OwnComparator) {
+  FlippedOrder::next_descending = true;
+  s21::PersistentMap<int, int, FlippedOrder> map = {{1, 1}, {3, 3}, {2, 2}};
+  FlippedOrder::next_descending = false;
+  s21::PersistentMap<int, int, FlippedOrder> more = map.insert(4, 4);
+  more = more.erase(2);
+  std::vector<int> keys;
+  for (auto item : map) keys.push_back(item.first);
+  ASSERT_EQ(keys, std::vector<int>({3, 2, 1}));
+  keys.clear();
+  for (auto item : more) keys.push_back(item.first);
+  ASSERT_EQ(keys, std::vector<int>({4, 3, 1}));
+  ASSERT_EQ((*more.upper_bound(3)).first, 1);
+}
+
+TEST(PersistentMapTest, ThrowingCopies) {
+  s21::PersistentMap<int, ThrowsOnCopy> map;
+  for (int i = 0; i < 64; ++i) map = map.insert(2 * i, ThrowsOnCopy(i));
+  // Each pass lets one more copy through, so that every node the update
+  // builds gets its turn to throw.
+  auto attempt = [&](auto update) {
+    size_t size = map.size();
+    for (int copies = 0;; ++copies) {
+      ThrowsOnCopy::throw_after = copies;
+      try {
+        map = update();
+        break;
+      } catch (const std::runtime_error &) {
+        ASSERT_EQ(map.size(), size);
+      }
+    }
+    ThrowsOnCopy::throw_after = -1;
+  };
+  attempt([&] { return map.insert(33, ThrowsOnCopy(33)); });
+  attempt([&] { return map.erase(64); });
+  attempt([&] { return map.insert_or_assign(0, ThrowsOnCopy(-1)); });
+  ASSERT_EQ(map.size(), 64);
+  ASSERT_TRUE(map.contains(33));
+  ASSERT_FALSE(map.contains(64));
+  ASSERT_EQ(map.at(0).value, -1);
+}
+
+TEST(PersistentMapTest, ReadersDuringWrites) {
+  s21::AtomicPersistentMap<int, int> map;
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (int key = 0; key < 2000; ++key) {
+      if (key % 2) {
+        map.update([key](const s21::PersistentMap<int, int> &current) {
+          return current.insert(key, key);
+        });
+      } else {
+        map.store(map.load().insert(key, key));
+      }
+    }
+    done = true;
+  });
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 3; ++t)
+    readers.emplace_back([&] {
+      while (!done) {
+        // Every version holds the keys below its size.
+        s21::PersistentMap<int, int> version = map.load();
+        int expected = 0;
+        for (auto item : version) ASSERT_EQ(item.first, expected++);
+        ASSERT_EQ(static_cast<size_t>(expected), version.size());
+      }
+    });
+  writer.join();
+  for (auto &reader : readers) reader.join();
+  ASSERT_EQ(map.load().size(), 2000);
+  ASSERT_TRUE(map.read([](const s21::PersistentMap<int, int> &version) {
+    return version.contains(1999);
+  }));
+}
+
 // S21_VECTOR
 TEST(VectorTest, VecBaseConstruct) {
   std::cout << "\n ============== TEST: S21_VECTOR ============== \n"